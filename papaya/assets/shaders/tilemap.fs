@@ -0,0 +1,27 @@
+#version 330
+
+// Whole tile layer in one quad. texture0 holds one texel per tile: the low byte of the atlas
+// id in red and the high byte in alpha (GRAY_ALPHA upload). Atlas texels are fetched exactly,
+// so neighbouring tiles never bleed into each other.
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform sampler2D atlas;
+uniform vec2 mapSize;
+uniform int atlasColumns;
+uniform int tileSize;
+
+out vec4 finalColor;
+
+void main() {
+    vec2 tilePos = fragTexCoord * mapSize;
+    vec4 index = texelFetch(texture0, ivec2(floor(tilePos)), 0);
+    int id = int(index.r * 255.0 + 0.5) + int(index.a * 255.0 + 0.5) * 256;
+    if (id == 0) discard;
+
+    ivec2 inTile = ivec2(fract(tilePos) * float(tileSize));
+    ivec2 atlasTexel = ivec2(id % atlasColumns, id / atlasColumns) * tileSize + inTile;
+    finalColor = texelFetch(atlas, atlasTexel, 0) * fragColor;
+}
@@ -1,4 +1,9 @@
 #include "AudioManager.hpp"
+#include "../Core/AssetCache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 
 // Inicjalizacja statycznego wskanika
 AudioManager* AudioManager::sInstance = nullptr;
@@ -16,52 +21,94 @@ void AudioManager::init() {
     else {
         std::cout << "[AUDIO] System audio gotowy." << std::endl;
     }
+
+    if (!mMusicThread.joinable()) {
+        mMusicThreadRunning = true;
+        mMusicThread = std::thread(&AudioManager::musicThreadMain, this);
+    }
+    sendMusicVolume();
 }
 
 void AudioManager::shutdown() {
-    stopMusic();
     cleanup();
     CloseAudioDevice();
     std::cout << "[AUDIO] Zamknieto system audio." << std::endl;
 }
 
+void AudioManager::stopMusicThread() {
+    // Wtek przy wyjciu sam zatrzymuje swoje strumienie
+    if (!mMusicThread.joinable()) return;
+    mMusicThreadRunning = false;
+    mMusicThread.join();
+}
+
 void AudioManager::cleanup() {
-    for (auto& pair : mSounds) {
-        UnloadSound(pair.second);
+    // Strumienie muzyki zwalniamy dopiero, gdy wtek muzyki przesta ich dotyka
+    stopMusicThread();
+
+    // Aliasy czytaj prbki rda z AssetCache - musz znikn, zanim cache zwolni rdo.
+    // Wyciszamy te rdo, eby mikser nie gra z bufora, ktry clear() zaraz usunie
+    for (auto& slot : mSoundSlots) {
+        for (Sound& voice : slot.voices) StopSound(voice);
+        for (size_t i = 1; i < slot.voices.size(); i++) UnloadSoundAlias(slot.voices[i]);
+        AssetCache::shared().releaseSound(slot.path);
     }
-    mSounds.clear();
+    mSoundSlots.clear();
+    mSoundNames.clear();
 
-    for (auto& pair : mMusic) {
-        UnloadMusicStream(pair.second);
+    for (auto& pair : mMusicPaths) {
+        AssetCache::shared().releaseMusic(pair.second);
     }
     mMusic.clear();
-    mCurrentMusic = nullptr;
+    mMusicPaths.clear();
 }
 
-void AudioManager::loadSound(const std::string& name, const std::string& path) {
-    if (mSounds.find(name) != mSounds.end()) return;
+SoundHandle AudioManager::loadSound(const std::string& name, const std::string& path) {
+    auto named = mSoundNames.find(name);
+    if (named != mSoundNames.end()) return named->second;
+
+    for (size_t i = 0; i < mSoundSlots.size(); i++) {
+        if (mSoundSlots[i].path == path) {
+            mSoundNames[name] = (SoundHandle)i;
+            return (SoundHandle)i;
+        }
+    }
 
     if (!FileExists(path.c_str())) {
         std::cerr << "[AUDIO ERROR] PLIK NIE ISTNIEJE: " << path << std::endl;
-        return;
+        return INVALID_SOUND;
     }
 
-    Sound snd = LoadSound(path.c_str());
-    if (snd.stream.buffer != 0) {
-        mSounds[name] = snd;
-        std::cout << "[AUDIO] Wczytano poprawnie: " << name << " (" << path << ")" << std::endl;
-    }
-    else {
+    Sound snd = AssetCache::shared().acquireSound(path);
+    if (snd.stream.buffer == 0) {
         std::cerr << "[AUDIO ERROR] Nie udalo sie zaladowac: " << path << std::endl;
+        return INVALID_SOUND;
     }
+
+    SoundSlot slot;
+    slot.path = path;
+    slot.voices.push_back(snd);
+    for (int i = 1; i < VOICES_PER_SOUND; i++) slot.voices.push_back(LoadSoundAlias(snd));
+
+    SoundHandle handle = (SoundHandle)mSoundSlots.size();
+    mSoundSlots.push_back(std::move(slot));
+    mSoundNames[name] = handle;
+    std::cout << "[AUDIO] Wczytano poprawnie: " << name << " (" << path << ")" << std::endl;
+    return handle;
+}
+
+SoundHandle AudioManager::findSound(const std::string& name) const {
+    auto it = mSoundNames.find(name);
+    return it != mSoundNames.end() ? it->second : INVALID_SOUND;
 }
 
 void AudioManager::loadMusic(const std::string& name, const std::string& path) {
     if (mMusic.find(name) != mMusic.end()) return;
 
-    Music mus = LoadMusicStream(path.c_str());
+    Music mus = AssetCache::shared().acquireMusic(path);
     if (mus.stream.buffer != 0) {
         mMusic[name] = mus;
+        mMusicPaths[name] = path;
         std::cout << "[AUDIO] Wczytano muzyke: " << name << std::endl;
     }
     else {
@@ -69,49 +116,242 @@ void AudioManager::loadMusic(const std::string& name, const std::string& path) {
     }
 }
 
-void AudioManager::playSound(const std::string& name, float pitch) {
-    if (mSounds.find(name) != mSounds.end()) {
-        Sound& s = mSounds[name];
-        SetSoundPitch(s, pitch);
-        SetSoundVolume(s, mSFXVolume * mMasterVolume);
-        PlaySound(s);
+void AudioManager::beginFrame() {
+    mVoicesStarted = 0;
+}
+
+void AudioManager::playSound(SoundHandle sound, float pitch) {
+    startVoice(sound, pitch, 1.0f, 0.5f);
+}
+
+void AudioManager::startVoice(SoundHandle sound, float pitch, float gain, float pan) {
+    if (sound < 0 || sound >= (SoundHandle)mSoundSlots.size()) return;
+    if (mVoicesStarted >= MAX_VOICES_PER_FRAME) return;
+
+    SoundSlot& slot = mSoundSlots[sound];
+    const int count = (int)slot.voices.size();
+
+    // Kolejne gosy po kolei; gdy wszystkie graj, kradniemy ten, ktry zacz najdawniej
+    int voice = slot.next;
+    for (int i = 0; i < count; i++) {
+        int candidate = (slot.next + i) % count;
+        if (!IsSoundPlaying(slot.voices[candidate])) {
+            voice = candidate;
+            break;
+        }
     }
+    slot.next = (voice + 1) % count;
+
+    Sound& s = slot.voices[voice];
+    StopSound(s);
+    SetSoundPitch(s, pitch);
+    SetSoundVolume(s, gain * mSFXVolume * mMasterVolume);
+    // Alias ma wasny pan, wic gos po dwiku pozycyjnym trzeba wycentrowa
+    SetSoundPan(s, pan);
+    PlaySound(s);
+    mVoicesStarted++;
 }
 
-void AudioManager::playSoundRandomPitch(const std::string& name, float minPitch, float maxPitch) {
+void AudioManager::playSoundRandomPitch(SoundHandle sound, float minPitch, float maxPitch) {
     float pitch = minPitch + (float)GetRandomValue(0, 100) / 100.0f * (maxPitch - minPitch);
-    playSound(name, pitch);
+    playSound(sound, pitch);
+}
+
+void AudioManager::setListenerPosition(Vector2 position) {
+    mListener = position;
+}
+
+void AudioManager::playSoundAt(SoundHandle sound, Vector2 position, float pitch) {
+    const float dx = position.x - mListener.x;
+    const float dy = position.y - mListener.y;
+    const float distanceSq = dx * dx + dy * dy;
+    // Poza zasigiem nie zajmujemy gosu ani limitu klatki
+    if (distanceSq >= SOUND_MAX_DISTANCE * SOUND_MAX_DISTANCE) return;
+
+    const float distance = std::sqrt(distanceSq);
+    const float gain = std::clamp(1.0f - (distance - SOUND_FULL_DISTANCE) / (SOUND_MAX_DISTANCE - SOUND_FULL_DISTANCE), 0.0f, 1.0f);
+    // raylib: 0.5 to rodek, 1.0 lewy kana, 0.0 prawy
+    const float pan = std::clamp(0.5f - 0.5f * dx / SOUND_PAN_WIDTH, 0.0f, 1.0f);
+    startVoice(sound, pitch, gain, pan);
 }
 
-void AudioManager::playMusic(const std::string& name, bool loop) {
-    if (mMusic.find(name) != mMusic.end()) {
-        if (mCurrentMusic) StopMusicStream(*mCurrentMusic);
+void AudioManager::playSoundRandomPitchAt(SoundHandle sound, Vector2 position, float minPitch, float maxPitch) {
+    float pitch = minPitch + (float)GetRandomValue(0, 100) / 100.0f * (maxPitch - minPitch);
+    playSoundAt(sound, position, pitch);
+}
 
-        mCurrentMusic = &mMusic[name];
-        mCurrentMusic->looping = loop;
-        SetMusicVolume(*mCurrentMusic, mMusicVolume * mMasterVolume);
-        PlayMusicStream(*mCurrentMusic);
+void AudioManager::sendMusicCommand(const MusicCommand& command) {
+    if (!mMusicCommands.push(command)) {
+        std::cerr << "[AUDIO] Kolejka muzyki pena, pominito polecenie" << std::endl;
     }
 }
 
-void AudioManager::updateMusic() {
-    if (mCurrentMusic) {
-        UpdateMusicStream(*mCurrentMusic);
+void AudioManager::sendMusicVolume() {
+    MusicCommand command;
+    command.type = MusicCommand::Type::VOLUME;
+    command.volume = mMusicVolume * mMasterVolume;
+    sendMusicCommand(command);
+}
+
+void AudioManager::playMusic(const std::string& name, bool loop, float fadeSeconds) {
+    auto it = mMusic.find(name);
+    if (it == mMusic.end()) return;
+
+    MusicCommand command;
+    command.type = MusicCommand::Type::PLAY;
+    command.tracks[0] = it->second;
+    command.trackCount = 1;
+    command.loop = loop;
+    command.fadeSeconds = fadeSeconds;
+    sendMusicCommand(command);
+}
+
+void AudioManager::playPlaylist(const std::vector<std::string>& names, float crossfadeSeconds) {
+    MusicCommand command;
+    command.type = MusicCommand::Type::PLAYLIST;
+    command.fadeSeconds = crossfadeSeconds;
+    for (const std::string& name : names) {
+        auto it = mMusic.find(name);
+        if (it == mMusic.end() || command.trackCount == MAX_PLAYLIST) continue;
+        command.tracks[command.trackCount++] = it->second;
     }
+    if (command.trackCount > 0) sendMusicCommand(command);
+}
+
+void AudioManager::stopMusic(float fadeSeconds) {
+    MusicCommand command;
+    command.type = MusicCommand::Type::STOP;
+    command.fadeSeconds = fadeSeconds;
+    sendMusicCommand(command);
 }
 
-void AudioManager::stopMusic() {
-    if (mCurrentMusic) {
-        StopMusicStream(*mCurrentMusic);
-        mCurrentMusic = nullptr;
+void AudioManager::musicThreadMain() {
+    // Cay stan odtwarzania yje tylko w tym wtku; gwny wtek rozmawia z nim przez kolejk
+    struct Voice {
+        Music music = {};
+        bool active = false;
+        float gain = 0.0f;
+        float fadeRate = 0.0f; // zmiana gain na sekund
+    };
+
+    Voice current;
+    Voice outgoing;
+    Music playlist[MAX_PLAYLIST] = {};
+    int playlistCount = 0;
+    int playlistIndex = 0;
+    float crossfade = 0.0f;
+    float volume = 0.0f;
+
+    auto stopVoice = [](Voice& voice) {
+        if (voice.active) StopMusicStream(voice.music);
+        voice = Voice{};
+    };
+
+    auto fadeOutCurrent = [&](float fadeSeconds) {
+        stopVoice(outgoing);
+        if (fadeSeconds > 0.0f && current.active) {
+            outgoing = current;
+            outgoing.fadeRate = -1.0f / fadeSeconds;
+            current = Voice{};
+        }
+        else {
+            stopVoice(current);
+        }
+    };
+
+    auto start = [&](Music music, bool loop, float fadeSeconds) {
+        if (current.active && current.music.stream.buffer == music.stream.buffer) {
+            current.music.looping = loop;
+            return;
+        }
+
+        fadeOutCurrent(fadeSeconds);
+        if (outgoing.active && outgoing.music.stream.buffer == music.stream.buffer) stopVoice(outgoing);
+
+        current.music = music;
+        current.music.looping = loop;
+        current.active = true;
+        current.gain = fadeSeconds > 0.0f ? 0.0f : 1.0f;
+        current.fadeRate = fadeSeconds > 0.0f ? 1.0f / fadeSeconds : 0.0f;
+        SetMusicVolume(current.music, volume * current.gain);
+        PlayMusicStream(current.music);
+    };
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point last = Clock::now();
+
+    while (mMusicThreadRunning) {
+        MusicCommand command;
+        while (mMusicCommands.pop(command)) {
+            switch (command.type) {
+            case MusicCommand::Type::PLAY:
+                playlistCount = 0;
+                start(command.tracks[0], command.loop, command.fadeSeconds);
+                break;
+            case MusicCommand::Type::PLAYLIST:
+                std::copy(command.tracks, command.tracks + command.trackCount, playlist);
+                playlistCount = command.trackCount;
+                playlistIndex = 0;
+                crossfade = command.fadeSeconds;
+                // Jednoutworowa playlista to po prostu zaptlony utwr
+                start(playlist[0], playlistCount == 1, crossfade);
+                break;
+            case MusicCommand::Type::STOP:
+                playlistCount = 0;
+                fadeOutCurrent(command.fadeSeconds);
+                break;
+            case MusicCommand::Type::VOLUME:
+                volume = command.volume;
+                break;
+            }
+        }
+
+        const Clock::time_point now = Clock::now();
+        const float dt = std::chrono::duration<float>(now - last).count();
+        last = now;
+
+        // Nastpny utwr wchodzi, zanim obecny si skoczy, wic na przejciu nie ma ciszy
+        if (playlistCount > 1) {
+            bool advance = !current.active;
+            if (current.active) {
+                float timeLeft = GetMusicTimeLength(current.music) - GetMusicTimePlayed(current.music);
+                advance = timeLeft <= crossfade;
+            }
+            if (advance) {
+                playlistIndex = (playlistIndex + 1) % playlistCount;
+                start(playlist[playlistIndex], false, crossfade);
+            }
+        }
+
+        for (Voice* voice : { &current, &outgoing }) {
+            if (!voice->active) continue;
+
+            voice->gain = std::clamp(voice->gain + voice->fadeRate * dt, 0.0f, 1.0f);
+            if (voice->fadeRate < 0.0f && voice->gain <= 0.0f) {
+                stopVoice(*voice);
+                continue;
+            }
+            if (voice->fadeRate > 0.0f && voice->gain >= 1.0f) voice->fadeRate = 0.0f;
+
+            SetMusicVolume(voice->music, volume * voice->gain);
+            UpdateMusicStream(voice->music);
+            // Niezaptlony utwr doszed do koca
+            if (!IsMusicStreamPlaying(voice->music)) *voice = Voice{};
+        }
+
+        mMusicPlaying = current.active;
+        std::this_thread::sleep_for(std::chrono::milliseconds(MUSIC_UPDATE_INTERVAL_MS));
     }
+
+    stopVoice(current);
+    stopVoice(outgoing);
+    mMusicPlaying = false;
 }
 
-void AudioManager::setMasterVolume(float vol) { mMasterVolume = vol; }
-void AudioManager::setMusicVolume(float vol) { mMusicVolume = vol; }
+void AudioManager::setMasterVolume(float vol) { mMasterVolume = vol; sendMusicVolume(); }
+void AudioManager::setMusicVolume(float vol) { mMusicVolume = vol; sendMusicVolume(); }
 void AudioManager::setSFXVolume(float vol) { mSFXVolume = vol; }
 
 bool AudioManager::isMusicPlaying() const {
-    if (!mCurrentMusic) return false;
-    return IsMusicStreamPlaying(*mCurrentMusic);
+    return mMusicPlaying;
 }
\ No newline at end of file
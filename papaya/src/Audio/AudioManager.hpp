@@ -1,15 +1,74 @@
 #pragma once
 #include "raylib.h"
+#include "../Core/SpscQueue.hpp"
+#include <atomic>
+#include <cstdint>
 #include <unordered_map>
 #include <string>
+#include <thread>
+#include <vector>
 #include <iostream>
 
+// Index of a loaded sound, resolved once so playing it needs no string lookup
+using SoundHandle = int;
+constexpr SoundHandle INVALID_SOUND = -1;
+
 class AudioManager {
+public:
+    // Voices (LoadSoundAlias copies sharing the samples) per sound, so rapid repeats overlap
+    static constexpr int VOICES_PER_SOUND = 4;
+    // New voices allowed to start in one frame; the rest of a burst is dropped
+    static constexpr int MAX_VOICES_PER_FRAME = 6;
+    // Positional sounds (world pixels from the listener): full volume up to FULL, silent and
+    // never started from MAX on; fully to one side at PAN_WIDTH, half the screen width
+    static constexpr float SOUND_FULL_DISTANCE = 48.0f;
+    static constexpr float SOUND_MAX_DISTANCE = 320.0f;
+    static constexpr float SOUND_PAN_WIDTH = 160.0f;
+    // Tracks a playlist can cycle through
+    static constexpr int MAX_PLAYLIST = 4;
+    // How often the music thread refills the streams; well under the length of raylib's stream buffer
+    static constexpr int MUSIC_UPDATE_INTERVAL_MS = 5;
+
 private:
-    std::unordered_map<std::string, Sound> mSounds;
+    struct SoundSlot {
+        std::string path;
+        // Voice 0 is the cached source itself, the others are aliases owned here. Aliases share
+        // the source's samples, so cleanup() unloads them before AssetCache may free the source
+        std::vector<Sound> voices;
+        int next = 0;
+    };
+
+    std::vector<SoundSlot> mSoundSlots;
+    std::unordered_map<std::string, SoundHandle> mSoundNames;
+    int mVoicesStarted = 0;
+    Vector2 mListener = { 0.0f, 0.0f };
+
+    void startVoice(SoundHandle sound, float pitch, float gain, float pan);
+
+    // Sent from the main thread to the music thread, which alone touches the streams once they play
+    struct MusicCommand {
+        enum class Type : uint8_t { PLAY, PLAYLIST, STOP, VOLUME };
+        Type type = Type::STOP;
+        Music tracks[MAX_PLAYLIST] = {};
+        int trackCount = 0;
+        bool loop = false;
+        float fadeSeconds = 0.0f;
+        float volume = 0.0f;
+    };
+
     std::unordered_map<std::string, Music> mMusic;
+    // Paths the tracks were acquired with from AssetCache, by name
+    std::unordered_map<std::string, std::string> mMusicPaths;
+
+    SpscQueue<MusicCommand, 32> mMusicCommands;
+    std::thread mMusicThread;
+    std::atomic<bool> mMusicThreadRunning{ false };
+    std::atomic<bool> mMusicPlaying{ false };
 
-    Music* mCurrentMusic = nullptr;
+    void sendMusicCommand(const MusicCommand& command);
+    void stopMusicThread();
+    void sendMusicVolume();
+    void musicThreadMain();
 
     float mMasterVolume = 1.0f;
     float mMusicVolume = 0.5f;
@@ -22,19 +81,38 @@ public:
     static AudioManager* getInstance();
 
     void init();
+    // Closes the audio device; call after AssetCache::clear(), which still needs the device
     void shutdown();
+    // Joins the music thread before anything is released; must run before AssetCache::clear()
+    // unloads the streams the thread plays
     void cleanup();
 
-    void loadSound(const std::string& name, const std::string& path);
+    // Names sharing a path share the handle; INVALID_SOUND when the file could not be loaded
+    SoundHandle loadSound(const std::string& name, const std::string& path);
+    SoundHandle findSound(const std::string& name) const;
     void loadMusic(const std::string& name, const std::string& path);
 
-    void playSound(const std::string& name, float pitch = 1.0f);
-    void playSoundRandomPitch(const std::string& name, float minPitch = 0.6f, float maxPitch = 0.9f);
+    // Resets the per-frame voice budget; call once per frame
+    void beginFrame();
+
+    // Plays on a free voice of the sound, or steals the one started longest ago
+    void playSound(SoundHandle sound, float pitch = 1.0f);
+    void playSoundRandomPitch(SoundHandle sound, float minPitch = 0.6f, float maxPitch = 0.9f);
+
+    // Where positional sounds are heard from; the camera position, updated every frame
+    void setListenerPosition(Vector2 position);
+    // Attenuated and panned relative to the listener; out of range it costs no voice at all
+    void playSoundAt(SoundHandle sound, Vector2 position, float pitch = 1.0f);
+    void playSoundRandomPitchAt(SoundHandle sound, Vector2 position, float minPitch = 0.6f, float maxPitch = 0.9f);
 
-    void playMusic(const std::string& name, bool loop = true);
-    void updateMusic();
-    void stopMusic();
+    // Music is decoded and streamed on its own thread, so frame spikes do not starve it.
+    // A positive fadeSeconds crossfades from whatever is playing instead of cutting it.
+    void playMusic(const std::string& name, bool loop = true, float fadeSeconds = 0.0f);
+    // Plays the tracks in order and wraps around, crossfading into each next track before the current one ends
+    void playPlaylist(const std::vector<std::string>& names, float crossfadeSeconds);
+    void stopMusic(float fadeSeconds = 0.0f);
 
+    // As of the music thread's last update, so it lags a freshly sent command by a few milliseconds
     bool isMusicPlaying() const;
 
     void setMasterVolume(float vol);
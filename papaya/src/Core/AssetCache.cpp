@@ -0,0 +1,184 @@
+#include "AssetCache.hpp"
+#include "Profiler.hpp"
+#include "ThreadPool.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace {
+    template<typename Map, typename Load, typename Valid>
+    auto acquireFrom(Map& entries, const std::string& path, Load load, Valid valid) {
+        auto it = entries.find(path);
+        if (it != entries.end()) {
+            it->second.refs++;
+            return it->second.asset;
+        }
+
+        PROFILE_SCOPE("AssetCache::load");
+        auto asset = load(path.c_str());
+        if (!valid(asset)) {
+            std::cerr << "[ASSETS] Nie udało się wczytać: " << path << std::endl;
+            return asset;
+        }
+
+        auto& entry = entries[path];
+        entry.asset = asset;
+        entry.refs = 1;
+        return asset;
+    }
+
+    template<typename Map, typename Asset>
+    void insertUnowned(Map& entries, const std::string& path, const Asset& asset) {
+        auto& entry = entries[path];
+        entry.asset = asset;
+        entry.refs = 0;
+    }
+
+    template<typename Map>
+    void releaseFrom(Map& entries, const std::string& path) {
+        // Zasób zostaje w pamięci także bez właścicieli - zwalnia go dopiero clear()
+        auto it = entries.find(path);
+        if (it != entries.end() && it->second.refs > 0) it->second.refs--;
+    }
+
+    template<typename Map, typename Unload>
+    int unloadAll(Map& entries, Unload unload) {
+        int inUse = 0;
+        for (auto& [path, entry] : entries) {
+            if (entry.refs > 0) inUse++;
+            unload(entry.asset);
+        }
+        entries.clear();
+        return inUse;
+    }
+
+    bool validTexture(const Texture2D& texture) { return texture.id > 0; }
+    bool validSound(const Sound& sound) { return sound.stream.buffer != nullptr; }
+    bool validMusic(const Music& music) { return music.stream.buffer != nullptr; }
+}
+
+AssetCache& AssetCache::shared() {
+    static AssetCache cache;
+    return cache;
+}
+
+Texture2D AssetCache::acquireTexture(const std::string& path) {
+    finishPendingTexture(path);
+    return acquireFrom(mTextures, path, LoadTexture, validTexture);
+}
+
+Sound AssetCache::acquireSound(const std::string& path) {
+    finishPendingSound(path);
+    return acquireFrom(mSounds, path, LoadSound, validSound);
+}
+
+Music AssetCache::acquireMusic(const std::string& path) {
+    return acquireFrom(mMusic, path, LoadMusicStream, validMusic);
+}
+
+void AssetCache::releaseTexture(const std::string& path) { releaseFrom(mTextures, path); }
+void AssetCache::releaseSound(const std::string& path) { releaseFrom(mSounds, path); }
+void AssetCache::releaseMusic(const std::string& path) { releaseFrom(mMusic, path); }
+
+void AssetCache::prefetchTexture(const std::string& path) {
+    if (mTextures.count(path) || mPendingTextures.count(path)) return;
+    mPendingTextures.emplace(path, ThreadPool::shared().submit([path]() {
+        PROFILE_SCOPE("AssetCache::decodeImage");
+        return LoadImage(path.c_str());
+        }));
+}
+
+void AssetCache::prefetchSound(const std::string& path) {
+    if (mSounds.count(path) || mPendingSounds.count(path)) return;
+    mPendingSounds.emplace(path, ThreadPool::shared().submit([path]() {
+        PROFILE_SCOPE("AssetCache::decodeWave");
+        return LoadWave(path.c_str());
+        }));
+}
+
+void AssetCache::finishPendingTexture(const std::string& path) {
+    auto it = mPendingTextures.find(path);
+    if (it == mPendingTextures.end()) return;
+
+    PROFILE_SCOPE("AssetCache::uploadTexture");
+    Image image = it->second.get();
+    mPendingTextures.erase(it);
+
+    // Wysłanie do GPU tylko z głównego wątku - tam żyje kontekst OpenGL
+    Texture2D texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+    if (validTexture(texture)) insertUnowned(mTextures, path, texture);
+    else std::cerr << "[ASSETS] Nie udało się wczytać: " << path << std::endl;
+}
+
+void AssetCache::finishPendingSound(const std::string& path) {
+    auto it = mPendingSounds.find(path);
+    if (it == mPendingSounds.end()) return;
+
+    PROFILE_SCOPE("AssetCache::uploadSound");
+    Wave wave = it->second.get();
+    mPendingSounds.erase(it);
+
+    Sound sound = LoadSoundFromWave(wave);
+    UnloadWave(wave);
+    if (validSound(sound)) insertUnowned(mSounds, path, sound);
+    else std::cerr << "[ASSETS] Nie udało się wczytać: " << path << std::endl;
+}
+
+size_t AssetCache::pumpUploads(double budgetSeconds) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    auto budgetLeft = [&]() {
+        return std::chrono::duration<double>(Clock::now() - start).count() < budgetSeconds;
+    };
+
+    std::vector<std::string> ready;
+    for (const auto& [path, task] : mPendingTextures) {
+        if (task.wait_for(std::chrono::seconds(0)) == std::future_status::ready) ready.push_back(path);
+    }
+    for (size_t i = 0; i < ready.size() && (i == 0 || budgetLeft()); ++i) finishPendingTexture(ready[i]);
+
+    ready.clear();
+    for (const auto& [path, task] : mPendingSounds) {
+        if (task.wait_for(std::chrono::seconds(0)) == std::future_status::ready) ready.push_back(path);
+    }
+    for (size_t i = 0; i < ready.size() && budgetLeft(); ++i) finishPendingSound(ready[i]);
+
+    return pendingCount();
+}
+
+Texture2D AssetCache::reloadTexture(const std::string& path) {
+    auto it = mTextures.find(path);
+    if (it == mTextures.end()) {
+        Texture2D texture = acquireTexture(path);
+        // Przeładowanie nie przejmuje zasobu na własność
+        releaseTexture(path);
+        return texture;
+    }
+
+    Texture2D texture = LoadTexture(path.c_str());
+    if (!validTexture(texture)) {
+        std::cerr << "[ASSETS] Przeładowanie nieudane, zostaje stara wersja: " << path << std::endl;
+        return it->second.asset;
+    }
+
+    UnloadTexture(it->second.asset);
+    it->second.asset = texture;
+    mTextureGeneration++;
+    return texture;
+}
+
+void AssetCache::clear() {
+    // Niedokończone dekodowania trzeba odebrać, żeby zwolnić ich bufory
+    for (auto& [path, task] : mPendingTextures) UnloadImage(task.get());
+    for (auto& [path, task] : mPendingSounds) UnloadWave(task.get());
+    mPendingTextures.clear();
+    mPendingSounds.clear();
+
+    int inUse = unloadAll(mTextures, UnloadTexture);
+    inUse += unloadAll(mSounds, UnloadSound);
+    inUse += unloadAll(mMusic, UnloadMusicStream);
+
+    if (inUse > 0) std::cout << "[ASSETS] Zwolniono " << inUse << " zasobów wciąż w użyciu" << std::endl;
+}
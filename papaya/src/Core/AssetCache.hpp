@@ -0,0 +1,70 @@
+#pragma once
+
+#include "raylib.h"
+
+#include <cstddef>
+#include <future>
+#include <string>
+#include <unordered_map>
+
+// Textures, sounds and music shared by path. Every acquire bumps a reference count and must be
+// matched by a release, but an asset nobody holds stays loaded: scenes that come back get the
+// same handle without decoding the file again. Main thread only, like the raylib calls inside;
+// prefetch*() only moves the file decode onto the shared thread pool.
+class AssetCache {
+public:
+    AssetCache() = default;
+    ~AssetCache() = default;
+
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    static AssetCache& shared();
+
+    // Failed loads are not cached and return an empty handle (id 0 / null buffer)
+    Texture2D acquireTexture(const std::string& path);
+    Sound acquireSound(const std::string& path);
+    Music acquireMusic(const std::string& path);
+
+    void releaseTexture(const std::string& path);
+    void releaseSound(const std::string& path);
+    void releaseMusic(const std::string& path);
+
+    // Starts decoding the file (LoadImage / LoadWave) on a worker; pumpUploads() turns the result
+    // into a cached asset. Acquiring a path still in flight waits for its decode.
+    void prefetchTexture(const std::string& path);
+    void prefetchSound(const std::string& path);
+
+    // Uploads finished decodes until `budgetSeconds` is spent, at least one per call.
+    // Returns how many prefetches are still pending.
+    size_t pumpUploads(double budgetSeconds);
+    size_t pendingCount() const { return mPendingTextures.size() + mPendingSounds.size(); }
+
+    // Loads the file again in place (editor atlas hot reload); holders must fetch the new handle
+    Texture2D reloadTexture(const std::string& path);
+    // Bumped by every reload that replaced a texture; holders compare it to spot stale handles
+    unsigned int textureGeneration() const { return mTextureGeneration; }
+
+    // Unloads everything; call before CloseWindow and before the audio device closes
+    void clear();
+
+private:
+    template<typename T>
+    struct Entry {
+        T asset;
+        int refs = 0;
+    };
+
+    std::unordered_map<std::string, Entry<Texture2D>> mTextures;
+    std::unordered_map<std::string, Entry<Sound>> mSounds;
+    std::unordered_map<std::string, Entry<Music>> mMusic;
+
+    std::unordered_map<std::string, std::future<Image>> mPendingTextures;
+    std::unordered_map<std::string, std::future<Wave>> mPendingSounds;
+
+    unsigned int mTextureGeneration = 0;
+
+    // Blocks on the path's decode, if any, and caches the result with no holders
+    void finishPendingTexture(const std::string& path);
+    void finishPendingSound(const std::string& path);
+};
@@ -0,0 +1,98 @@
+#include "ChunkRenderCache.hpp"
+#include "GameConstants.hpp"
+#include "Profiler.hpp"
+
+using namespace GameConstants;
+
+void ChunkRenderCache::beginFrame() {
+    mFrame++;
+    mBakesLeft = MAX_BAKES_PER_FRAME;
+}
+
+void ChunkRenderCache::prepare(Layers layer, ChunkKey key, uint32_t revision, const uint16_t* tiles, Texture2D tileset) {
+    EntryMap& entries = mEntries[(int)layer];
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        it->second.lastUsed = mFrame;
+        if (it->second.revision == revision) return;
+    }
+    if (mBakesLeft <= 0) return;
+
+    PROFILE_SCOPE("ChunkRenderCache::bake");
+    if (it == entries.end()) {
+        if (size() >= MAX_ENTRIES) evictLeastRecent();
+
+        Entry entry;
+        entry.target = LoadRenderTexture(PAGE_PIXELS, PAGE_PIXELS);
+        SetTextureFilter(entry.target.texture, TEXTURE_FILTER_POINT);
+        entry.lastUsed = mFrame;
+        it = entries.emplace(key, entry).first;
+    }
+
+    BeginTextureMode(it->second.target);
+    ClearBackground(BLANK);
+    drawTiles(tiles, tileset, { 0, 0 }, 0, 0, CHUNK_SIZE - 1, CHUNK_SIZE - 1);
+    EndTextureMode();
+
+    it->second.revision = revision;
+    mBakesLeft--;
+}
+
+const Texture2D* ChunkRenderCache::find(Layers layer, ChunkKey key, uint32_t revision) {
+    EntryMap& entries = mEntries[(int)layer];
+    auto it = entries.find(key);
+    if (it == entries.end() || it->second.revision != revision) return nullptr;
+    it->second.lastUsed = mFrame;
+    return &it->second.target.texture;
+}
+
+void ChunkRenderCache::release(ChunkKey key) {
+    for (auto& entries : mEntries) {
+        auto it = entries.find(key);
+        if (it == entries.end()) continue;
+        UnloadRenderTexture(it->second.target);
+        entries.erase(it);
+    }
+}
+
+void ChunkRenderCache::clear() {
+    for (auto& entries : mEntries) {
+        for (auto& [key, entry] : entries) UnloadRenderTexture(entry.target);
+        entries.clear();
+    }
+}
+
+size_t ChunkRenderCache::size() const {
+    size_t total = 0;
+    for (const auto& entries : mEntries) total += entries.size();
+    return total;
+}
+
+void ChunkRenderCache::evictLeastRecent() {
+    EntryMap* oldestMap = nullptr;
+    EntryMap::iterator oldest;
+    for (auto& entries : mEntries) {
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (!oldestMap || it->second.lastUsed < oldest->second.lastUsed) {
+                oldestMap = &entries;
+                oldest = it;
+            }
+        }
+    }
+    if (!oldestMap) return;
+
+    UnloadRenderTexture(oldest->second.target);
+    oldestMap->erase(oldest);
+}
+
+void ChunkRenderCache::drawTiles(const uint16_t* tiles, Texture2D tileset, Vector2 origin, int x0, int y0, int x1, int y1) {
+    for (int ly = y0; ly <= y1; ++ly) {
+        const uint16_t* row = tiles + ly * CHUNK_SIZE;
+        for (int lx = x0; lx <= x1; ++lx) {
+            int id = row[lx];
+            if (id == 0) continue;
+            Rectangle src = { (float)(id % ATLAS_COLUMNS) * TILE_SIZE_PX, (float)(id / ATLAS_COLUMNS) * TILE_SIZE_PX, (float)TILE_SIZE_PX, (float)TILE_SIZE_PX };
+            DrawTextureRec(tileset, src, { origin.x + lx * TILE_SIZE_PX, origin.y + ly * TILE_SIZE_PX }, WHITE);
+        }
+    }
+}
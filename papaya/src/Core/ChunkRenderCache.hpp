@@ -0,0 +1,59 @@
+#pragma once
+
+#include "raylib.h"
+#include "../Map/map.hpp"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+// Static tiles of each map chunk and layer baked once into a RenderTexture2D, so a visible
+// chunk layer costs one quad instead of a draw per tile. Entries are keyed by layer and chunk
+// and tagged with the page revision they were baked from; a newer revision re-bakes on prepare.
+class ChunkRenderCache {
+public:
+    static constexpr int PAGE_PIXELS = CHUNK_SIZE * TILE_SIZE;
+    static constexpr int MAX_BAKES_PER_FRAME = 4;
+    static constexpr size_t MAX_ENTRIES = 48;
+
+    ChunkRenderCache() = default;
+    ~ChunkRenderCache() = default;
+
+    ChunkRenderCache(const ChunkRenderCache&) = delete;
+    ChunkRenderCache& operator=(const ChunkRenderCache&) = delete;
+
+    // Resets the per-frame bake budget
+    void beginFrame();
+
+    // Bakes the page if it is missing or stale and the frame budget allows it.
+    // Must be called outside BeginTextureMode.
+    void prepare(Layers layer, ChunkKey key, uint32_t revision, const uint16_t* tiles, Texture2D tileset);
+
+    // Baked texture matching `revision`, or nullptr when the chunk has to be drawn tile by tile
+    const Texture2D* find(Layers layer, ChunkKey key, uint32_t revision);
+
+    // Drops the chunk from every layer
+    void release(ChunkKey key);
+    // Unloads every texture; call before the window closes
+    void clear();
+
+    size_t size() const;
+
+    // Draws tiles[y0..y1][x0..x1] of a CHUNK_SIZE x CHUNK_SIZE page with its top-left tile at `origin`
+    static void drawTiles(const uint16_t* tiles, Texture2D tileset, Vector2 origin, int x0, int y0, int x1, int y1);
+
+private:
+    struct Entry {
+        RenderTexture2D target;
+        uint32_t revision = 0;
+        uint64_t lastUsed = 0;
+    };
+
+    using EntryMap = std::unordered_map<ChunkKey, Entry>;
+
+    std::array<EntryMap, LAYER_COUNT> mEntries;
+    uint64_t mFrame = 0;
+    int mBakesLeft = MAX_BAKES_PER_FRAME;
+
+    void evictLeastRecent();
+};
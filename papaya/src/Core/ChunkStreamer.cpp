@@ -0,0 +1,203 @@
+#include "ChunkStreamer.hpp"
+#include "GameConstants.hpp"
+#include "Profiler.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace GameConstants;
+
+namespace {
+    MapData loadChunkFromFile(const std::filesystem::path& mapPath, ChunkKey key) {
+        PROFILE_SCOPE("ChunkStreamer::loadChunk");
+        // Osobny strumień na zadanie - MapLoader nie jest współdzielony między wątkami
+        std::fstream file(mapPath, std::ios::in | std::ios::binary);
+        MapLoader loader(file, mapPath);
+        return loader.loadChunk(chunkKeyX(key), chunkKeyY(key));
+    }
+
+    int chebyshev(ChunkKey a, int chunkX, int chunkY) {
+        return std::max(std::abs(chunkKeyX(a) - chunkX), std::abs(chunkKeyY(a) - chunkY));
+    }
+
+    void appendMapData(MapData& out, const MapData& chunk) {
+        out.collisions.insert(out.collisions.end(), chunk.collisions.begin(), chunk.collisions.end());
+        out.damagingZones.insert(out.damagingZones.end(), chunk.damagingZones.begin(), chunk.damagingZones.end());
+        out.renderTiles.insert(out.renderTiles.end(), chunk.renderTiles.begin(), chunk.renderTiles.end());
+        out.blockCount += chunk.blockCount;
+    }
+}
+
+int ChunkStreamer::worldToChunk(float pixel) {
+    return static_cast<int>(std::floor(pixel / (CHUNK_SIZE * TILE_SIZE_PX)));
+}
+
+void ChunkStreamer::open(const std::string& saveFolder) {
+    PROFILE_SCOPE("ChunkStreamer::open");
+    close();
+
+    Saves saves(saveFolder);
+    mSaveFolder = saveFolder;
+    mMapPath = std::filesystem::path(saveFolder) / "map.bin";
+
+    mEntities = saves.getEntities().getAll();
+    for (size_t i = 0; i < mEntities.size(); ++i) {
+        ChunkKey key = makeChunkKey(tileToChunk(mEntities[i].x), tileToChunk(mEntities[i].y));
+        mChunkEntities[key].push_back(i);
+    }
+    listExisting(saves);
+
+    std::cout << "[STREAM] " << mExisting.size() << " chunków w mapie, " << mEntities.size() << " encji" << std::endl;
+}
+
+void ChunkStreamer::listExisting(Saves& saves) {
+    mExisting.clear();
+    for (const auto& [chunkX, chunkY] : saves.getMap().listChunks()) {
+        mExisting.insert(makeChunkKey(chunkX, chunkY));
+    }
+
+    // Chunk z samymi encjami też musi się wczytać, żeby je stworzyć
+    for (const auto& [key, records] : mChunkEntities) mExisting.insert(key);
+}
+
+std::vector<ChunkKey> ChunkStreamer::reloadChunks(const std::vector<ChunkKey>& keys) {
+    PROFILE_SCOPE("ChunkStreamer::reloadChunks");
+    std::vector<ChunkKey> reloaded;
+    if (mMapPath.empty()) return reloaded;
+
+    Saves saves(mSaveFolder);
+    listExisting(saves);
+
+    for (ChunkKey key : keys) {
+        mPrefetched.erase(key);
+        mPending.erase(key);
+
+        auto it = mResident.find(key);
+        if (it == mResident.end()) continue;
+        it->second = loadChunkFromFile(mMapPath, key);
+        reloaded.push_back(key);
+    }
+    return reloaded;
+}
+
+void ChunkStreamer::waitPending() {
+    // Odczyty sprzed importu widzą stary, spójny plik; zmienione chunki wyrzuci potem reloadChunks()
+    for (auto& [key, task] : mPending) mPrefetched.emplace(key, task.get());
+    mPending.clear();
+}
+
+void ChunkStreamer::close() {
+    // Czekamy na rozpoczęte odczyty - import w tle może zaraz nadpisać map.bin
+    waitPending();
+    mPrefetched.clear();
+    mResident.clear();
+    mExisting.clear();
+    mMapPath.clear();
+    mEntities.clear();
+    mChunkEntities.clear();
+    mLoaded.clear();
+    mEvicted.clear();
+}
+
+void ChunkStreamer::requestChunk(ChunkKey key) {
+    if (!mExisting.count(key) || mResident.count(key) || mPrefetched.count(key) || mPending.count(key)) return;
+
+    std::filesystem::path mapPath = mMapPath;
+    mPending.emplace(key, ThreadPool::shared().submit([mapPath, key]() {
+        return loadChunkFromFile(mapPath, key);
+        }));
+}
+
+void ChunkStreamer::collectFinished() {
+    for (auto it = mPending.begin(); it != mPending.end();) {
+        if (it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            mPrefetched.emplace(it->first, it->second.get());
+            it = mPending.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+MapData ChunkStreamer::takeChunk(ChunkKey key) {
+    auto ready = mPrefetched.find(key);
+    if (ready != mPrefetched.end()) {
+        MapData data = std::move(ready->second);
+        mPrefetched.erase(ready);
+        return data;
+    }
+
+    // Prefetch nie zdążył - czekamy, bo bez tego chunka gracz nie ma kolizji
+    auto pending = mPending.find(key);
+    if (pending != mPending.end()) {
+        MapData data = pending->second.get();
+        mPending.erase(pending);
+        return data;
+    }
+
+    return loadChunkFromFile(mMapPath, key);
+}
+
+bool ChunkStreamer::update(Vector2 camera, Vector2 velocity) {
+    PROFILE_SCOPE("ChunkStreamer::update");
+    mLoaded.clear();
+    mEvicted.clear();
+    if (mExisting.empty()) return false;
+
+    collectFinished();
+
+    const int camX = worldToChunk(camera.x);
+    const int camY = worldToChunk(camera.y);
+    const int aheadX = worldToChunk(camera.x + velocity.x * STREAM_PREFETCH_TIME);
+    const int aheadY = worldToChunk(camera.y + velocity.y * STREAM_PREFETCH_TIME);
+
+    for (int y = aheadY - STREAM_RADIUS_CHUNKS; y <= aheadY + STREAM_RADIUS_CHUNKS; ++y) {
+        for (int x = aheadX - STREAM_RADIUS_CHUNKS; x <= aheadX + STREAM_RADIUS_CHUNKS; ++x) {
+            requestChunk(makeChunkKey(x, y));
+        }
+    }
+
+    for (int y = camY - STREAM_RADIUS_CHUNKS; y <= camY + STREAM_RADIUS_CHUNKS; ++y) {
+        for (int x = camX - STREAM_RADIUS_CHUNKS; x <= camX + STREAM_RADIUS_CHUNKS; ++x) {
+            ChunkKey key = makeChunkKey(x, y);
+            if (!mExisting.count(key) || mResident.count(key)) continue;
+
+            mResident.emplace(key, takeChunk(key));
+            mLoaded.push_back(key);
+        }
+    }
+
+    for (auto it = mResident.begin(); it != mResident.end();) {
+        if (chebyshev(it->first, camX, camY) > STREAM_KEEP_RADIUS_CHUNKS) {
+            mEvicted.push_back(it->first);
+            it = mResident.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // Gotowe chunki, do których kamera już nie zmierza
+    for (auto it = mPrefetched.begin(); it != mPrefetched.end();) {
+        bool nearCamera = chebyshev(it->first, camX, camY) <= STREAM_KEEP_RADIUS_CHUNKS;
+        bool nearAhead = chebyshev(it->first, aheadX, aheadY) <= STREAM_KEEP_RADIUS_CHUNKS;
+        if (!nearCamera && !nearAhead) it = mPrefetched.erase(it);
+        else ++it;
+    }
+
+    return !mLoaded.empty() || !mEvicted.empty();
+}
+
+MapData ChunkStreamer::residentMapData() const {
+    MapData merged;
+    for (const auto& [key, chunk] : mResident) appendMapData(merged, chunk);
+    return merged;
+}
+
+const std::vector<size_t>* ChunkStreamer::entitiesInChunk(ChunkKey key) const {
+    auto it = mChunkEntities.find(key);
+    return it != mChunkEntities.end() ? &it->second : nullptr;
+}
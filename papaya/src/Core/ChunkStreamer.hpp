@@ -0,0 +1,75 @@
+#pragma once
+
+#include "raylib.h"
+#include "../Map/map.hpp"
+#include "../Saves/saves.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Keeps only the map chunks around the camera in memory. Chunks ahead of the camera are
+// decoded on the shared thread pool; a chunk that is needed before its prefetch finishes
+// is waited for (or loaded in place) so collisions are never missing under the player.
+class ChunkStreamer {
+public:
+    ChunkStreamer() = default;
+    ~ChunkStreamer() = default;
+
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    // Reads the chunk directory and all entity records of the slot; nothing is resident yet.
+    void open(const std::string& saveFolder);
+    void close();
+
+    // Finishes every read in flight and keeps the results as prefetched chunks;
+    // call before anything rewrites map.bin under the streamer
+    void waitPending();
+
+    // Makes the chunks within the stream radius of `camera` resident, prefetches around where
+    // `velocity` leads and evicts chunks past the keep radius. True when the resident set changed.
+    bool update(Vector2 camera, Vector2 velocity);
+
+    // Picks up chunks rewritten on disk (editor hot reload): resident ones are reloaded
+    // in place, stale prefetches are dropped. Returns the reloaded resident keys.
+    std::vector<ChunkKey> reloadChunks(const std::vector<ChunkKey>& keys);
+
+    const std::map<ChunkKey, MapData>& resident() const { return mResident; }
+    // All resident chunks merged into one MapData
+    MapData residentMapData() const;
+
+    const std::vector<ChunkKey>& loadedChunks() const { return mLoaded; }
+    const std::vector<ChunkKey>& evictedChunks() const { return mEvicted; }
+
+    const std::vector<EntityS>& entityRecords() const { return mEntities; }
+    // Indices into entityRecords() of the entities spawning in the chunk
+    const std::vector<size_t>* entitiesInChunk(ChunkKey key) const;
+
+    static int worldToChunk(float pixel);
+
+private:
+    std::string mSaveFolder;
+    std::filesystem::path mMapPath;
+    std::unordered_set<ChunkKey> mExisting;
+
+    std::map<ChunkKey, MapData> mResident;
+    std::unordered_map<ChunkKey, MapData> mPrefetched;
+    std::unordered_map<ChunkKey, std::future<MapData>> mPending;
+
+    std::vector<EntityS> mEntities;
+    std::unordered_map<ChunkKey, std::vector<size_t>> mChunkEntities;
+
+    std::vector<ChunkKey> mLoaded;
+    std::vector<ChunkKey> mEvicted;
+
+    void listExisting(Saves& saves);
+    void requestChunk(ChunkKey key);
+    void collectFinished();
+    MapData takeChunk(ChunkKey key);
+};
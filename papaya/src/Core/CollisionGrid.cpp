@@ -0,0 +1,174 @@
+#include "CollisionGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // How far past the queried area row runs are followed before being clipped
+    constexpr int QUERY_MARGIN_TILES = 4;
+
+    int lastTile(float pixelEnd) {
+        return static_cast<int>(std::ceil(pixelEnd / TILE_SIZE)) - 1;
+    }
+
+    struct TileRun {
+        int x0, x1;
+        int y0;
+        bool continued;
+    };
+}
+
+int CollisionGrid::toTile(float pixel) {
+    return static_cast<int>(std::floor(pixel / TILE_SIZE));
+}
+
+void CollisionGrid::init(const std::vector<CollisionRect>& rects) {
+    clear();
+    if (rects.empty()) return;
+
+    int minX = rects[0].x, minY = rects[0].y;
+    int maxX = rects[0].x + rects[0].w, maxY = rects[0].y + rects[0].h;
+
+    for (const auto& r : rects) {
+        minX = std::min(minX, r.x);
+        minY = std::min(minY, r.y);
+        maxX = std::max(maxX, r.x + r.w);
+        maxY = std::max(maxY, r.y + r.h);
+    }
+
+    minTileX = toTile((float)minX);
+    minTileY = toTile((float)minY);
+    width = lastTile((float)maxX) - minTileX + 1;
+    height = lastTile((float)maxY) - minTileY + 1;
+    solid.assign(static_cast<size_t>(width) * height, 0);
+
+    for (const auto& r : rects) {
+        int x0 = toTile((float)r.x) - minTileX;
+        int y0 = toTile((float)r.y) - minTileY;
+        int x1 = lastTile((float)(r.x + r.w)) - minTileX;
+        int y1 = lastTile((float)(r.y + r.h)) - minTileY;
+
+        for (int y = y0; y <= y1; ++y) {
+            std::fill(solid.begin() + y * width + x0, solid.begin() + y * width + x1 + 1, 1);
+        }
+    }
+
+    const int stride = width + 1;
+    solidSum.assign(static_cast<size_t>(stride) * (height + 1), 0);
+    for (int y = 0; y < height; ++y) {
+        uint32_t rowSum = 0;
+        for (int x = 0; x < width; ++x) {
+            rowSum += solid[y * width + x];
+            solidSum[(y + 1) * stride + x + 1] = solidSum[y * stride + x + 1] + rowSum;
+        }
+    }
+}
+
+void CollisionGrid::clear() {
+    minTileX = 0;
+    minTileY = 0;
+    width = 0;
+    height = 0;
+    solid.clear();
+    solidSum.clear();
+}
+
+bool CollisionGrid::isSolidTile(int tileX, int tileY) const {
+    int x = tileX - minTileX;
+    int y = tileY - minTileY;
+    if (x < 0 || x >= width || y < 0 || y >= height) return false;
+    return solid[y * width + x] != 0;
+}
+
+bool CollisionGrid::isSolidAt(float x, float y) const {
+    return isSolidTile(toTile(x), toTile(y));
+}
+
+int CollisionGrid::countSolidTiles(int tileX0, int tileY0, int tileX1, int tileY1) const {
+    int x0 = std::max(tileX0 - minTileX, 0);
+    int y0 = std::max(tileY0 - minTileY, 0);
+    int x1 = std::min(tileX1 - minTileX, width - 1);
+    int y1 = std::min(tileY1 - minTileY, height - 1);
+    if (x0 > x1 || y0 > y1) return 0;
+
+    const int stride = width + 1;
+    return static_cast<int>(solidSum[(y1 + 1) * stride + x1 + 1] - solidSum[y0 * stride + x1 + 1]
+        - solidSum[(y1 + 1) * stride + x0] + solidSum[y0 * stride + x0]);
+}
+
+bool CollisionGrid::isAreaFree(Rectangle area) const {
+    return countSolidTiles(toTile(area.x), toTile(area.y), lastTile(area.x + area.width), lastTile(area.y + area.height)) == 0;
+}
+
+bool CollisionGrid::overlapsCircle(Vector2 center, float radius) const {
+    int x0 = toTile(center.x - radius);
+    int y0 = toTile(center.y - radius);
+    int x1 = toTile(center.x + radius);
+    int y1 = toTile(center.y + radius);
+
+    for (int ty = y0; ty <= y1; ++ty) {
+        for (int tx = x0; tx <= x1; ++tx) {
+            if (!isSolidTile(tx, ty)) continue;
+            Rectangle tileRect = { (float)(tx * TILE_SIZE), (float)(ty * TILE_SIZE), (float)TILE_SIZE, (float)TILE_SIZE };
+            if (CheckCollisionCircleRec(center, radius, tileRect)) return true;
+        }
+    }
+    return false;
+}
+
+void CollisionGrid::querySolids(Rectangle area, std::vector<Rectangle>& outRects) const {
+    int x0 = std::max(toTile(area.x) - QUERY_MARGIN_TILES, minTileX);
+    int y0 = std::max(toTile(area.y) - QUERY_MARGIN_TILES, minTileY);
+    int x1 = std::min(lastTile(area.x + area.width) + QUERY_MARGIN_TILES, minTileX + width - 1);
+    int y1 = std::min(lastTile(area.y + area.height) + QUERY_MARGIN_TILES, minTileY + height - 1);
+    if (x0 > x1 || y0 > y1) return;
+
+    thread_local std::vector<TileRun> open;
+    thread_local std::vector<TileRun> next;
+    open.clear();
+
+    auto emit = [&](const TileRun& run, int lastRow) {
+        Rectangle rect = {
+            (float)(run.x0 * TILE_SIZE),
+            (float)(run.y0 * TILE_SIZE),
+            (float)((run.x1 - run.x0 + 1) * TILE_SIZE),
+            (float)((lastRow - run.y0 + 1) * TILE_SIZE)
+        };
+        if (CheckCollisionRecs(rect, area)) outRects.push_back(rect);
+        };
+
+    for (int ty = y0; ty <= y1; ++ty) {
+        next.clear();
+        const uint8_t* row = &solid[(ty - minTileY) * width];
+
+        int tx = x0;
+        while (tx <= x1) {
+            if (!row[tx - minTileX]) {
+                tx++;
+                continue;
+            }
+
+            int start = tx;
+            while (tx <= x1 && row[tx - minTileX]) tx++;
+            int end = tx - 1;
+
+            // A run with the same span as one in the row above extends it downwards
+            TileRun run = { start, end, ty, false };
+            for (auto& above : open) {
+                if (!above.continued && above.x0 == start && above.x1 == end) {
+                    above.continued = true;
+                    run.y0 = above.y0;
+                    break;
+                }
+            }
+            next.push_back(run);
+        }
+
+        for (const auto& above : open) {
+            if (!above.continued) emit(above, ty - 1);
+        }
+        std::swap(open, next);
+    }
+
+    for (const auto& run : open) emit(run, y1);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "raylib.h"
+#include "../Map/map.hpp"
+
+#include <vector>
+#include <cstdint>
+
+// Solid tiles of the level, one byte per tile over the bounding box of all collisions.
+struct CollisionGrid {
+    int minTileX = 0;
+    int minTileY = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> solid;
+    // Summed-area table of `solid`, (width + 1) x (height + 1) with a zero first row and column
+    std::vector<uint32_t> solidSum;
+
+    void init(const std::vector<CollisionRect>& rects);
+    void clear();
+
+    bool isSolidTile(int tileX, int tileY) const;
+    bool isSolidAt(float x, float y) const;
+    // Number of solid tiles in the inclusive tile range, in constant time.
+    int countSolidTiles(int tileX0, int tileY0, int tileX1, int tileY1) const;
+    bool isAreaFree(Rectangle area) const;
+    bool overlapsCircle(Vector2 center, float radius) const;
+
+    // Solid tiles touching `area`, merged into row runs and stacked into rectangles
+    // (clipped to a few tiles around the area) for actors to resolve against.
+    void querySolids(Rectangle area, std::vector<Rectangle>& outRects) const;
+
+    static int toTile(float pixel);
+};
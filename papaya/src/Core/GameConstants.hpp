@@ -8,13 +8,37 @@ namespace GameConstants {
     constexpr int TILE_SIZE_PX = 8;
     constexpr int ATLAS_COLUMNS = 64;
 
+    // Symulacja ze stałym krokiem, niezależna od FPS
+    constexpr float SIM_DT = 1.0f / 120.0f;
+    constexpr int MAX_SIM_STEPS = 8;
+    constexpr float MAX_FRAME_TIME = 0.25f;
+
+    // Strumieniowanie mapy: w pamięci tylko chunki wokół kamery
+    constexpr bool STREAM_WORLD = true;
+    constexpr int STREAM_RADIUS_CHUNKS = 1;
+    constexpr int STREAM_KEEP_RADIUS_CHUNKS = 2;
+    constexpr float STREAM_PREFETCH_TIME = 1.0f;
+
+    // Kafelki jednym quadem z shaderem zamiast wypieczonych chunków; przełączane F6
+    constexpr bool TILEMAP_SHADER_DEFAULT = false;
+
+    // Czas na klatkę na wysyłanie zdekodowanych tekstur i dźwięków podczas ładowania
+    constexpr double ASSET_UPLOAD_BUDGET = 0.004;
+
+    // Przenikanie między utworami muzyki w tle
+    constexpr float MUSIC_CROSSFADE_TIME = 3.0f;
+
     inline const std::string TILESET_PATH = "assets/tiles/atlas_512x512.png";
     inline const std::string PLAYER_TEXTURE_PATH = "assets/player.png";
     inline const std::string BOSS_TEXTURE_PATH = "assets/mage_boss.png";
     inline const std::string RABBIT_TEXTURE_PATH = "assets/rabbit.png";
+    inline const std::string SLASH_TEXTURE_PATH = "assets/slash.png";
+    inline const std::string WINGS_TEXTURE_PATH = "assets/jump_wings.png";
     inline const std::string BACKGROUND_PATH = "assets/background.png";
+    inline const std::string TILEMAP_SHADER_PATH = "assets/shaders/tilemap.fs";
 
     inline const std::string EDITOR_PATH = "assets/editor";
+    inline const std::string TRACE_PATH = "papaya_trace.json";
 
     inline std::string currentSavePath = "assets/saves/main_save";
 }
\ No newline at end of file
@@ -1,54 +1,137 @@
 #include "GameWrapper.hpp"
 #include "Physics.hpp"
+#include "InputHelper.h"
+#include "Profiler.hpp"
+#include "AssetCache.hpp"
 #include "Audio/AudioManager.hpp"
 
 #include "../Saves/saves.hpp"
 #include "../Entities/Entity.h"
 #include "../Entities/Player/Player.h"
-#include "../Entities/Environment/Wall.h"
 #include "../Entities/Enemies/mage_boss.h"
 #include "../Entities/Enemies/rabbit.h"
 
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 
 using namespace GameConstants;
 
+namespace {
+    struct SoundFile {
+        const char* name;
+        const char* path;
+    };
+
+    const SoundFile SOUND_FILES[] = {
+        { "jump", "assets/audio/jump.wav" },
+        { "dash", "assets/audio/jump.wav" },
+        { "attack", "assets/audio/attack.wav" },
+        { "hurt", "assets/audio/hurt.wav" },
+        { "death", "assets/audio/death.wav" },
+    };
+}
+
 // =============================================================================
 // MAPA I KAMERA
 // =============================================================================
 
 void GameMap::init(const std::vector<RenderTile>& rawTiles) {
-    if (rawTiles.empty()) return;
+    clear();
+    addTiles(rawTiles);
+}
+
+void GameMap::clear() {
+    for (auto& pages : layers) pages.clear();
+    version++;
+    updateBounds();
+}
 
-    int minPixelX = 999999, minPixelY = 999999;
-    int maxPixelX = -999999, maxPixelY = -999999;
+int GameMap::layerIndex(Layers layer) {
+    return std::min((int)layer, LAYER_COUNT - 1);
+}
 
+void GameMap::addTiles(const std::vector<RenderTile>& rawTiles) {
+    const uint32_t revision = nextRevision++;
+    version++;
     for (const auto& t : rawTiles) {
-        if (t.x < minPixelX) minPixelX = t.x;
-        if (t.y < minPixelY) minPixelY = t.y;
-        if (t.x > maxPixelX) maxPixelX = t.x;
-        if (t.y > maxPixelY) maxPixelY = t.y;
+        int tileX = t.x / TILE_SIZE_PX;
+        int tileY = t.y / TILE_SIZE_PX;
+        int chunkX = tileToChunk(tileX);
+        int chunkY = tileToChunk(tileY);
+
+        auto& page = layers[layerIndex(t.layer)][makeChunkKey(chunkX, chunkY)];
+        if (!page) page = std::make_unique<Page>();
+        page->revision = revision;
+        page->tiles[(tileY - chunkY * PAGE_SIZE) * PAGE_SIZE + (tileX - chunkX * PAGE_SIZE)] = t.textureID;
     }
+    updateBounds();
+}
 
-    minX = minPixelX;
-    minY = minPixelY;
-    width = (maxPixelX - minPixelX) / TILE_SIZE_PX + 1;
-    height = (maxPixelY - minPixelY) / TILE_SIZE_PX + 1;
-    tiles.assign(width * height, 0);
+void GameMap::removePage(ChunkKey key) {
+    bool removed = false;
+    for (auto& pages : layers) removed |= pages.erase(key) > 0;
+    if (!removed) return;
+    version++;
+    updateBounds();
+}
 
-    for (const auto& t : rawTiles) {
-        int gx = (t.x - minX) / TILE_SIZE_PX;
-        int gy = (t.y - minY) / TILE_SIZE_PX;
-        if (gx >= 0 && gx < width && gy >= 0 && gy < height) {
-            tiles[gy * width + gx] = static_cast<int>(t.textureID);
+void GameMap::updateBounds() {
+    int minChunkX = INT32_MAX, minChunkY = INT32_MAX;
+    int maxChunkX = INT32_MIN, maxChunkY = INT32_MIN;
+    for (const auto& pages : layers) {
+        for (const auto& [key, page] : pages) {
+            minChunkX = std::min(minChunkX, chunkKeyX(key));
+            minChunkY = std::min(minChunkY, chunkKeyY(key));
+            maxChunkX = std::max(maxChunkX, chunkKeyX(key));
+            maxChunkY = std::max(maxChunkY, chunkKeyY(key));
         }
     }
+
+    if (minChunkX > maxChunkX) {
+        width = height = minX = minY = 0;
+        return;
+    }
+
+    minX = minChunkX * PAGE_SIZE * TILE_SIZE_PX;
+    minY = minChunkY * PAGE_SIZE * TILE_SIZE_PX;
+    width = (maxChunkX - minChunkX + 1) * PAGE_SIZE;
+    height = (maxChunkY - minChunkY + 1) * PAGE_SIZE;
+}
+
+const GameMap::Page* GameMap::findPage(Layers layer, int chunkX, int chunkY) const {
+    const PageMap& pages = layers[layerIndex(layer)];
+    auto it = pages.find(makeChunkKey(chunkX, chunkY));
+    return it != pages.end() ? it->second.get() : nullptr;
+}
+
+uint16_t GameMap::getTileAt(int tileX, int tileY, Layers layer) const {
+    int chunkX = tileToChunk(tileX);
+    int chunkY = tileToChunk(tileY);
+    const Page* page = findPage(layer, chunkX, chunkY);
+    if (!page) return 0;
+    return page->tiles[(tileY - chunkY * PAGE_SIZE) * PAGE_SIZE + (tileX - chunkX * PAGE_SIZE)];
 }
 
-int GameMap::getTileAt(int gridX, int gridY) const {
-    if (gridX < 0 || gridX >= width || gridY < 0 || gridY >= height) return 0;
-    return tiles[gridY * width + gridX];
+void GameMap::copyRegion(Layers layer, int tileX, int tileY, int w, int h, uint16_t* out) const {
+    std::fill(out, out + w * h, 0);
+
+    // Kopiujemy wiersze stronami, bez szukania strony dla kadego kafelka
+    for (int chunkY = tileToChunk(tileY); chunkY <= tileToChunk(tileY + h - 1); ++chunkY) {
+        for (int chunkX = tileToChunk(tileX); chunkX <= tileToChunk(tileX + w - 1); ++chunkX) {
+            const Page* page = findPage(layer, chunkX, chunkY);
+            if (!page) continue;
+
+            const int originX = chunkX * PAGE_SIZE, originY = chunkY * PAGE_SIZE;
+            const int x0 = std::max(tileX, originX), x1 = std::min(tileX + w, originX + PAGE_SIZE);
+            const int y0 = std::max(tileY, originY), y1 = std::min(tileY + h, originY + PAGE_SIZE);
+            for (int y = y0; y < y1; ++y) {
+                const uint16_t* row = page->tiles.data() + (y - originY) * PAGE_SIZE;
+                std::copy(row + (x0 - originX), row + (x1 - originX), out + (y - tileY) * w + (x0 - tileX));
+            }
+        }
+    }
 }
 
 void SpatialGrid::init(int mapW, int mapH, int minX_, int minY_) {
@@ -56,31 +139,71 @@ void SpatialGrid::init(int mapW, int mapH, int minX_, int minY_) {
     offsetY = minY_;
     width = (mapW / cellSize) + 2;
     height = (mapH / cellSize) + 2;
-    cells.assign(width * height, {});
+    cellStart.assign(width * height + 1, 0);
+    cellItems.clear();
+    bounds.clear();
 }
 
 void SpatialGrid::clear() {
-    for (auto& cell : cells) {
-        cell.clear();
-    }
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    cellItems.clear();
+    bounds.clear();
+    queryStamps.clear();
 }
 
-void SpatialGrid::insertStatic(Entity* e) {
-    int cx = std::clamp(((int)e->mPosition.x - offsetX) / cellSize, 0, width - 1);
-    int cy = std::clamp(((int)e->mPosition.y - offsetY) / cellSize, 0, height - 1);
-    cells[cy * width + cx].push_back(e);
+void SpatialGrid::cellRange(Rectangle r, int& x0, int& y0, int& x1, int& y1) const {
+    x0 = std::clamp((int)std::floor((r.x - offsetX) / cellSize), 0, width - 1);
+    y0 = std::clamp((int)std::floor((r.y - offsetY) / cellSize), 0, height - 1);
+    x1 = std::clamp((int)std::floor((r.x + r.width - offsetX) / cellSize), 0, width - 1);
+    y1 = std::clamp((int)std::floor((r.y + r.height - offsetY) / cellSize), 0, height - 1);
 }
 
-void SpatialGrid::getNearby(float x, float y, std::vector<Entity*>& outResult) const {
-    int cx = ((int)x - offsetX) / cellSize;
-    int cy = ((int)y - offsetY) / cellSize;
+void SpatialGrid::build(const std::vector<Rectangle>& rects) {
+    if (width <= 0 || height <= 0) return;
 
-    for (int ny = cy - 1; ny <= cy + 1; ny++) {
-        for (int nx = cx - 1; nx <= cx + 1; nx++) {
-            if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                const auto& cell = cells[ny * width + nx];
-                outResult.insert(outResult.end(), cell.begin(), cell.end());
-            }
+    bounds = rects;
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+
+    // Zliczanie -> sumy prefiksowe -> rozoenie id po komrkach
+    int x0, y0, x1, y1;
+    for (const Rectangle& r : bounds) {
+        cellRange(r, x0, y0, x1, y1);
+        for (int cy = y0; cy <= y1; cy++)
+            for (int cx = x0; cx <= x1; cx++)
+                cellStart[cy * width + cx + 1]++;
+    }
+    for (size_t i = 1; i < cellStart.size(); i++) cellStart[i] += cellStart[i - 1];
+
+    cellItems.resize(cellStart.back());
+    cellCursor.assign(cellStart.begin(), cellStart.end() - 1);
+    for (int id = 0; id < (int)bounds.size(); id++) {
+        cellRange(bounds[id], x0, y0, x1, y1);
+        for (int cy = y0; cy <= y1; cy++)
+            for (int cx = x0; cx <= x1; cx++)
+                cellItems[cellCursor[cy * width + cx]++] = id;
+    }
+
+    queryStamps.assign(bounds.size(), 0);
+    currentStamp = 0;
+}
+
+void SpatialGrid::getNearby(Rectangle area, std::vector<int>& outIds) const {
+    if (bounds.empty()) return;
+
+    if (++currentStamp == 0) {
+        std::fill(queryStamps.begin(), queryStamps.end(), 0);
+        currentStamp = 1;
+    }
+
+    int x0, y0, x1, y1;
+    cellRange(area, x0, y0, x1, y1);
+    for (int cy = y0; cy <= y1; cy++) {
+        const int rowBase = cy * width;
+        for (int i = cellStart[rowBase + x0]; i < cellStart[rowBase + x1 + 1]; i++) {
+            int id = cellItems[i];
+            if (queryStamps[id] == currentStamp) continue;
+            queryStamps[id] = currentStamp;
+            outIds.push_back(id);
         }
     }
 }
@@ -152,24 +275,6 @@ GameWrapper::GameWrapper(bool& shouldQuit, int& state)
 
     AudioManager::getInstance()->init();
 
-    {
-        Saves tempSaves(currentSavePath);
-        if (tempSaves.getMap().getRenderData().empty()) {
-            std::cout << "[SYSTEM] Wykryto pusty save startowy. Prba importu..." << std::endl;
-            try {
-                tempSaves.loadFromEditorDir(EDITOR_PATH);
-            }
-            catch (const std::exception& e) {
-                std::cout << "[ERROR] Bd importu: " << e.what() << std::endl;
-            }
-        }
-    }
-
-    loadTextures();
-    loadAudio();
-    loadMap();
-    loadEntities();
-
     mCamera = { 0 };
     mCamera.zoom = 1.0f;
     mCamera.offset = { (float)VIRTUAL_WIDTH / 2, (float)VIRTUAL_HEIGHT / 2 };
@@ -177,95 +282,137 @@ GameWrapper::GameWrapper(bool& shouldQuit, int& state)
     mRenderTarget = LoadRenderTexture(VIRTUAL_WIDTH, VIRTUAL_HEIGHT);
     SetTextureFilter(mRenderTarget.texture, TEXTURE_FILTER_POINT);
 
-    if (mPlayerPtr) {
-        mSmoothCamera.setPosition(mPlayerPtr->mPosition);
+    // PNG i WAV dekoduj si w tle razem z importem mapy; reszt koczy updateLoading()
+    AssetCache& assets = AssetCache::shared();
+    for (const std::string& path : { TILESET_PATH, PLAYER_TEXTURE_PATH, BOSS_TEXTURE_PATH, RABBIT_TEXTURE_PATH,
+        BACKGROUND_PATH, SLASH_TEXTURE_PATH, WINGS_TEXTURE_PATH }) {
+        assets.prefetchTexture(path);
+    }
+    for (const SoundFile& sound : SOUND_FILES) {
+        if (FileExists(sound.path)) assets.prefetchSound(sound.path);
     }
 
-    mInitialized = true;
-    std::cout << "[GameWrapper] Gotowy!" << std::endl;
+    beginLoading();
 }
 
 GameWrapper::~GameWrapper() {
     std::cout << "[GameWrapper] Zamykanie (zapis stanu)..." << std::endl;
+    if (mImportTask.valid()) mImportTask.wait();
     saveGame();
     unloadTextures();
-    AudioManager::getInstance()->shutdown();
+    // Urzdzenie audio zamyka main() dopiero po AssetCache::clear()
+    AudioManager::getInstance()->cleanup();
     UnloadRenderTexture(mRenderTarget);
 }
 
 void GameWrapper::loadAudio() {
     AudioManager* am = AudioManager::getInstance();
 
-    am->loadSound("jump", "assets/audio/jump.wav");
-    am->loadSound("dash", "assets/audio/jump.wav");
-    am->loadSound("attack", "assets/audio/attack.wav");
-    am->loadSound("hurt", "assets/audio/hurt.wav");
-    am->loadSound("death", "assets/audio/death.wav");
+    for (const SoundFile& sound : SOUND_FILES) am->loadSound(sound.name, sound.path);
+    mHurtSound = am->findSound("hurt");
+    mDeathSound = am->findSound("death");
 
-    //am->loadMusic("bgm1", "assets/audio/Abyss.ogg");
-    //am->loadMusic("bgm2", "assets/audio/Abyss_deep.ogg");
+    am->loadMusic("bgm1", "assets/audio/Abyss.ogg");
+    am->loadMusic("bgm2", "assets/audio/Abyss_deep.ogg");
 
-    mCurrentMusicTrack = 1;
-    am->playMusic("bgm1", false);
+    // Abyss i Abyss_deep na zmian, z przenikaniem na wtku muzyki
+    am->playPlaylist({ "bgm1", "bgm2" }, MUSIC_CROSSFADE_TIME);
 }
 
-void GameWrapper::updateBackgroundMusic() {
-    AudioManager* am = AudioManager::getInstance();
-
-    if (!am->isMusicPlaying()) {
-
-        if (mCurrentMusicTrack == 1) {
-            mCurrentMusicTrack = 2;
-            am->playMusic("bgm2", false);
-            std::cout << "[AUDIO] Track 1 koniec -> Gramy Abyss_deep" << std::endl;
+void GameWrapper::beginLoading() {
+    // Poprzedni import mg jeszcze pracowa na tym samym slocie
+    if (mImportTask.valid()) mImportTask.wait();
+    mStreamer.close();
+
+    mLoading = true;
+    mLoadTotal = AssetCache::shared().pendingCount() + 1;
+
+    // Tylko chunki zmienione od ostatniego importu (manifest w slocie). Osobny wtek, nie pula:
+    // import sam rozdziela pliki na pul i czeka na nie, co przy jednym workerze by si zakleszczyo
+    const std::string savePath = currentSavePath;
+    mImportTask = std::async(std::launch::async, [savePath]() {
+        PROFILE_SCOPE("importEditorChunks");
+        Saves tempSaves(savePath);
+        try {
+            tempSaves.loadFromEditorDir(EDITOR_PATH);
         }
-        else {
-            mCurrentMusicTrack = 1;
-            am->playMusic("bgm1", false);
-            std::cout << "[AUDIO] Track 2 koniec -> Gramy Abyss" << std::endl;
+        catch (const std::exception& e) {
+            std::cout << "[ERROR] Bd importu: " << e.what() << std::endl;
         }
-    }
+        });
 }
 
-void GameWrapper::reloadSave() {
+bool GameWrapper::updateLoading() {
+    PROFILE_SCOPE("updateLoading");
+    if (AssetCache::shared().pumpUploads(ASSET_UPLOAD_BUDGET) > 0) return false;
+    if (mImportTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
 
-    std::cout << "[GameWrapper] Przeczanie na slot: " << currentSavePath << std::endl;
+    mImportTask.get();
+    completeLoading();
+    return true;
+}
 
-    mActiveEntities.clear();
-    mWallEntities.clear();
-    mBosses.clear();
-    mRabbits.clear();
-    mBossSpawnPoints.clear();
-    mLiquidRects.clear();
-    mNearbyObstacles.clear();
-    mPlayerPtr = nullptr;
-    mCollisionGrid.clear();
+void GameWrapper::finishLoading() {
+    while (mLoading && !updateLoading()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
 
-    {
-        Saves tempSaves(currentSavePath);
-        if (tempSaves.getMap().getRenderData().empty()) {
-            std::cout << "[SYSTEM] Nowy slot pusty - import z edytora..." << std::endl;
-            try {
-                tempSaves.loadFromEditorDir(EDITOR_PATH);
-            }
-            catch (const std::exception& e) {
-                std::cout << "[ERROR] Bd importu: " << e.what() << std::endl;
-            }
-        }
+float GameWrapper::loadProgress() const {
+    if (!mLoading || mLoadTotal == 0) return 1.0f;
+    size_t left = AssetCache::shared().pendingCount();
+    if (mImportTask.valid() && mImportTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready) left++;
+    return 1.0f - (float)std::min(left, mLoadTotal) / mLoadTotal;
+}
+
+void GameWrapper::completeLoading() {
+    PROFILE_SCOPE("completeLoading");
+    // Tekstury i dwiki s ju w AssetCache, tu tylko je odbieramy
+    if (!mInitialized) {
+        loadTextures();
+        loadAudio();
+    }
+    else if (mTextureGeneration != AssetCache::shared().textureGeneration()) {
+        // Edytor przeadowa atlas (F2) - stare uchwyty i wypieczone chunki wskazuj na usunite tekstury
+        unloadTextures();
+        loadTextures();
     }
 
     loadMap();
     loadEntities();
 
     if (mPlayerPtr) {
-        std::cout << "[RELOAD] Gracz ustawiony na: " << mPlayerPtr->mPosition.x << ", " << mPlayerPtr->mPosition.y << std::endl;
+        std::cout << "[LOAD] Gracz ustawiony na: " << mPlayerPtr->mPosition.x << ", " << mPlayerPtr->mPosition.y << std::endl;
         mSmoothCamera.setPosition(mPlayerPtr->mPosition);
         mCamera.target = mSmoothCamera.getPosition();
-        mCheats.showMessage("GAME LOADED");
+        if (mInitialized) mCheats.showMessage("GAME LOADED");
     }
     else {
-        std::cout << "[RELOAD] BD: Gracz nie zosta stworzony!" << std::endl;
+        std::cout << "[LOAD] BD: Gracz nie zosta stworzony!" << std::endl;
     }
+
+    mLoading = false;
+    mInitialized = true;
+    std::cout << "[GameWrapper] Gotowy!" << std::endl;
+}
+
+void GameWrapper::reloadSave() {
+
+    std::cout << "[GameWrapper] Przeczanie na slot: " << currentSavePath << std::endl;
+
+    mActiveEntities.clear();
+    mBosses.clear();
+    mRabbits.clear();
+    mBossSpawnPoints.clear();
+    mLiquidRects.clear();
+    mNearbyWalls.clear();
+    mNearbyIds.clear();
+    mPlayerPtr = nullptr;
+    mTileGrid.clear();
+    mCollisionGrid.clear();
+    mDynamicGrid.clear();
+
+    beginLoading();
 }
 
 void GameWrapper::saveGame() {
@@ -285,45 +432,69 @@ void GameWrapper::saveGame() {
 }
 
 void GameWrapper::loadTextures() {
-    mTileset = LoadTexture(TILESET_PATH.c_str());
-    mPlayerTexture = LoadTexture(PLAYER_TEXTURE_PATH.c_str());
-    mBossTexture = LoadTexture(BOSS_TEXTURE_PATH.c_str());
-    mRabbitTexture = LoadTexture(RABBIT_TEXTURE_PATH.c_str());
-    mBackground = LoadTexture(BACKGROUND_PATH.c_str());
+    AssetCache& assets = AssetCache::shared();
+    mTextureGeneration = assets.textureGeneration();
+    mTileset = assets.acquireTexture(TILESET_PATH);
+    mPlayerTexture = assets.acquireTexture(PLAYER_TEXTURE_PATH);
+    mBossTexture = assets.acquireTexture(BOSS_TEXTURE_PATH);
+    mRabbitTexture = assets.acquireTexture(RABBIT_TEXTURE_PATH);
+    mBackground = assets.acquireTexture(BACKGROUND_PATH);
 
     SetTextureFilter(mTileset, TEXTURE_FILTER_POINT);
     SetTextureFilter(mPlayerTexture, TEXTURE_FILTER_POINT);
     SetTextureFilter(mBossTexture, TEXTURE_FILTER_POINT);
     SetTextureFilter(mRabbitTexture, TEXTURE_FILTER_POINT);
     SetTextureFilter(mBackground, TEXTURE_FILTER_BILINEAR);
+
+    if (!mTileShader.load(TILEMAP_SHADER_PATH.c_str())) mUseTileShader = false;
 }
 
 void GameWrapper::unloadTextures() {
-    UnloadTexture(mTileset);
-    UnloadTexture(mPlayerTexture);
-    UnloadTexture(mBossTexture);
-    UnloadTexture(mRabbitTexture);
-    UnloadTexture(mBackground);
+    mChunkCache.clear();
+    mTileShader.unload();
+    // Tekstury zostaj w AssetCache - kolejne wejcie do gry ich nie dekoduje
+    AssetCache& assets = AssetCache::shared();
+    assets.releaseTexture(TILESET_PATH);
+    assets.releaseTexture(PLAYER_TEXTURE_PATH);
+    assets.releaseTexture(BOSS_TEXTURE_PATH);
+    assets.releaseTexture(RABBIT_TEXTURE_PATH);
+    assets.releaseTexture(BACKGROUND_PATH);
 }
 
 void GameWrapper::loadMap() {
+    PROFILE_SCOPE("loadMap");
+    if (STREAM_WORLD) {
+        // Chunki wok kamery dociga updateStreaming()
+        mStreamer.open(currentSavePath);
+        applyMapData(MapData{});
+        return;
+    }
+
     Saves saves(currentSavePath);
+    applyMapData(saves.getMap().loadAll());
+}
 
-    mGameMap.init(saves.getMap().getRenderData());
+void GameWrapper::applyMapData(const MapData& mapData) {
+    mChunkCache.clear();
+    mGameMap.init(mapData.renderTiles);
+    rebuildCollisionData(mapData);
+}
+
+void GameWrapper::rebuildCollisionData(const MapData& mapData) {
     mCollisionGrid.init(mGameMap.width * TILE_SIZE_PX + 1000, mGameMap.height * TILE_SIZE_PX + 1500, mGameMap.minX - 500, mGameMap.minY - 1000);
+    mDynamicGrid.init(mGameMap.width * TILE_SIZE_PX + 1000, mGameMap.height * TILE_SIZE_PX + 1500, mGameMap.minX - 500, mGameMap.minY - 1000);
 
-    auto collisions = saves.getMap().getCollisions();
-    for (const auto& col : collisions) {
-        auto wall = std::make_unique<Wall>((float)col.x, (float)col.y, (float)col.w, (float)col.h);
-        mCollisionGrid.insertStatic(wall.get());
-        mWallEntities.push_back(wall.get());
-        mActiveEntities.push_back(std::move(wall));
-    }
+    mTileGrid.init(mapData.collisions);
 
-    mLiquidRects = saves.getMap().getDamagingZones();
+    mLiquidRects.clear();
+    for (const auto& zone : mapData.damagingZones) {
+        mLiquidRects.push_back({ (float)zone.x, (float)zone.y, (float)zone.w, (float)zone.h });
+    }
+    mCollisionGrid.build(mLiquidRects);
 }
 
 void GameWrapper::loadEntities() {
+    PROFILE_SCOPE("loadEntities");
     Saves saves(currentSavePath);
 
     Vector2 spawnPos = mPlayerSpawnPoint;
@@ -351,29 +522,158 @@ void GameWrapper::loadEntities() {
         mActiveEntities.push_back(std::move(p));
     }
 
+    if (STREAM_WORLD) {
+        // Przeciwnicy powstaj razem ze swoim chunkiem
+        const auto& records = mStreamer.entityRecords();
+        mChunkEntities.clear();
+        mSpawnKilled.assign(records.size(), false);
+
+        bool anyEnemy = std::any_of(records.begin(), records.end(), [](const EntityS& e) {
+            return e.entityType == MAGE_BOSS || e.entityType == RABBIT;
+            });
+        if (!anyEnemy) createTestEnemies();
+        return;
+    }
+
     auto rawEntities = saves.getEntities().getAll();
-    for (const auto& e : rawEntities) {
-        if (e.entityType == PLAYER) continue;
-        float px = (float)(e.x * TILE_SIZE_PX);
-        float py = (float)(e.y * TILE_SIZE_PX);
-
-        if (e.entityType == MAGE_BOSS) {
-            auto boss = std::make_unique<MageBoss>(px, py, mBossTexture, mPlayerPtr);
-            Rectangle arena = { boss->mPosition.x - 116, boss->mPosition.y - 50, 232, 100 };
-            boss->setArenaBounds(arena.x, arena.y, arena.width, arena.height);
-            mBossSpawnPoints.push_back({ {px, py}, arena, boss->mMaxHealth });
-            mBosses.push_back(boss.get());
-            mActiveEntities.push_back(std::move(boss));
+    for (const auto& e : rawEntities) spawnEntity(e);
+
+    if (mBosses.empty() && mRabbits.empty()) createTestEnemies();
+}
+
+Entity* GameWrapper::spawnEntity(const EntityS& record) {
+    float px = (float)(record.x * TILE_SIZE_PX);
+    float py = (float)(record.y * TILE_SIZE_PX);
+
+    if (record.entityType == MAGE_BOSS) {
+        auto boss = std::make_unique<MageBoss>(px, py, mBossTexture, mPlayerPtr);
+        Rectangle arena = { boss->mPosition.x - 116, boss->mPosition.y - 50, 232, 100 };
+        boss->setArenaBounds(arena.x, arena.y, arena.width, arena.height);
+        mBossSpawnPoints.push_back({ {px, py}, arena, boss->mMaxHealth });
+        mBosses.push_back(boss.get());
+        mActiveEntities.push_back(std::move(boss));
+        return mBosses.back();
+    }
+    if (record.entityType == RABBIT) {
+        auto r = std::make_unique<RabbitEnemy>(px, py, mRabbitTexture, mPlayerPtr);
+        if (record.health > 0) r->mHealth = record.health;
+        mRabbits.push_back(r.get());
+        mActiveEntities.push_back(std::move(r));
+        return mRabbits.back();
+    }
+    return nullptr;
+}
+
+void GameWrapper::removeEntity(Entity* entity) {
+    auto bossIt = std::find(mBosses.begin(), mBosses.end(), entity);
+    if (bossIt != mBosses.end()) {
+        mBossSpawnPoints.erase(mBossSpawnPoints.begin() + (bossIt - mBosses.begin()));
+        mBosses.erase(bossIt);
+    }
+    mRabbits.erase(std::remove(mRabbits.begin(), mRabbits.end(), entity), mRabbits.end());
+
+    if (mPlayerPtr) {
+        auto& hits = mPlayerPtr->mHitEntities;
+        hits.erase(std::remove(hits.begin(), hits.end(), entity), hits.end());
+    }
+
+    mActiveEntities.erase(std::remove_if(mActiveEntities.begin(), mActiveEntities.end(),
+        [entity](const std::unique_ptr<Entity>& e) { return e.get() == entity; }), mActiveEntities.end());
+}
+
+void GameWrapper::updateStreaming() {
+    if (!STREAM_WORLD || !mPlayerPtr) return;
+
+    if (!mStreamer.update(mSmoothCamera.getPosition(), mPlayerPtr->mVelocity)) return;
+
+    PROFILE_SCOPE("applyStreamedChunks");
+    for (ChunkKey key : mStreamer.evictedChunks()) {
+        despawnChunkEntities(key);
+        mGameMap.removePage(key);
+        mChunkCache.release(key);
+    }
+    for (ChunkKey key : mStreamer.loadedChunks()) {
+        spawnChunkEntities(key);
+        mGameMap.addTiles(mStreamer.resident().at(key).renderTiles);
+    }
+
+    // Strony kafelkw zmieniaj si per chunk, siatki kolizji budujemy z caego obszaru
+    rebuildCollisionData(mStreamer.residentMapData());
+}
+
+void GameWrapper::hotReloadMap() {
+    PROFILE_SCOPE("hotReloadMap");
+    // Import przepisuje map.bin, a prefetch mg go wanie czyta przez mmap
+    mStreamer.waitPending();
+
+    std::vector<std::pair<int, int>> changed;
+    {
+        Saves saves(currentSavePath);
+        try {
+            changed = saves.loadFromEditorDir(EDITOR_PATH);
         }
-        else if (e.entityType == RABBIT) {
-            auto r = std::make_unique<RabbitEnemy>(px, py, mRabbitTexture, mPlayerPtr);
-            if (e.health > 0) r->mHealth = e.health;
-            mRabbits.push_back(r.get());
-            mActiveEntities.push_back(std::move(r));
+        catch (const std::exception& e) {
+            std::cout << "[ERROR] Bd importu: " << e.what() << std::endl;
+            return;
         }
     }
 
-    if (mBosses.empty() && mRabbits.empty()) createTestEnemies();
+    if (changed.empty()) {
+        mCheats.showMessage("MAP UP TO DATE");
+        return;
+    }
+
+    // Encje zostaj - podmieniamy tylko kafelki i kolizje zmienionych chunkw
+    if (STREAM_WORLD) {
+        std::vector<ChunkKey> keys;
+        for (const auto& [chunkX, chunkY] : changed) keys.push_back(makeChunkKey(chunkX, chunkY));
+
+        for (ChunkKey key : mStreamer.reloadChunks(keys)) {
+            mGameMap.removePage(key);
+            mGameMap.addTiles(mStreamer.resident().at(key).renderTiles);
+        }
+        rebuildCollisionData(mStreamer.residentMapData());
+    }
+    else {
+        Saves saves(currentSavePath);
+        MapData mapData = saves.getMap().loadAll();
+
+        std::vector<RenderTile> changedTiles;
+        for (const auto& [chunkX, chunkY] : changed) {
+            mGameMap.removePage(makeChunkKey(chunkX, chunkY));
+            MapData chunk = saves.getMap().loadChunk(chunkX, chunkY);
+            changedTiles.insert(changedTiles.end(), chunk.renderTiles.begin(), chunk.renderTiles.end());
+        }
+        mGameMap.addTiles(changedTiles);
+        rebuildCollisionData(mapData);
+    }
+
+    mCheats.showMessage(TextFormat("RELOADED %d CHUNKS", (int)changed.size()));
+}
+
+void GameWrapper::spawnChunkEntities(ChunkKey key) {
+    const std::vector<size_t>* records = mStreamer.entitiesInChunk(key);
+    if (!records) return;
+
+    auto& spawned = mChunkEntities[key];
+    for (size_t record : *records) {
+        if (mSpawnKilled[record]) continue;
+        if (Entity* entity = spawnEntity(mStreamer.entityRecords()[record])) {
+            spawned.push_back({ record, entity });
+        }
+    }
+}
+
+void GameWrapper::despawnChunkEntities(ChunkKey key) {
+    auto it = mChunkEntities.find(key);
+    if (it == mChunkEntities.end()) return;
+
+    // Pokonani nie wracaj, reszta odrodzi si przy ponownym wczytaniu chunka
+    for (const auto& streamed : it->second) {
+        if (!streamed.entity->mActive) mSpawnKilled[streamed.record] = true;
+        removeEntity(streamed.entity);
+    }
+    mChunkEntities.erase(it);
 }
 
 void GameWrapper::createTestEnemies() {
@@ -390,31 +690,102 @@ void GameWrapper::createTestEnemies() {
 }
 
 void GameWrapper::runFrame(int windowWidth, int windowHeight) {
-    float dt = std::min(GetFrameTime(), 0.033f);
+    PROFILE_SCOPE("frame");
+    updateFrame(GetFrameTime());
+    drawFrame(windowWidth, windowHeight);
+}
+
+void GameWrapper::updateFrame(float frameTime) {
+    PROFILE_SCOPE("updateFrame");
+    frameTime = std::min(frameTime, MAX_FRAME_TIME);
+
+    if (mLoading) {
+        updateLoading();
+        return;
+    }
+
+    AudioManager::getInstance()->beginFrame();
+
+    Input::LatchPressed();
+    handleInput(frameTime);
+    updateStreaming();
+
+    mSimAccumulator += frameTime;
+    int steps = 0;
+    while (mSimAccumulator >= SIM_DT) {
+        if (steps == MAX_SIM_STEPS) {
+            // Za due opnienie - gubimy zalegy czas zamiast nadrabia w nieskoczono
+            mSimAccumulator = 0.0f;
+            break;
+        }
+        stepSimulation(SIM_DT);
+        mSimAccumulator -= SIM_DT;
+        steps++;
+    }
+    mRenderAlpha = mSimAccumulator / SIM_DT;
+
+    updateCamera(frameTime);
 
-    AudioManager::getInstance()->updateMusic();
+    mCheats.update(frameTime);
+    mWeaponUI.update(frameTime);
+}
+
+void GameWrapper::drawFrame(int windowWidth, int windowHeight) {
+    if (mLoading) {
+        drawLoadingScreen(windowWidth, windowHeight);
+        return;
+    }
+    drawWorld();
+    drawUI(windowWidth, windowHeight);
+}
+
+void GameWrapper::drawLoadingScreen(int windowWidth, int windowHeight) {
+    BeginDrawing();
+    ClearBackground(BLACK);
+
+    const int barW = windowWidth / 3;
+    const int barH = 12;
+    const int barX = (windowWidth - barW) / 2;
+    const int barY = windowHeight / 2;
+
+    const char* txt = "LOADING";
+    DrawText(txt, (windowWidth - MeasureText(txt, 24)) / 2, barY - 40, 24, { 200, 200, 220, 255 });
+    DrawRectangleLines(barX - 2, barY - 2, barW + 4, barH + 4, { 60, 70, 110, 255 });
+    DrawRectangle(barX, barY, (int)(barW * loadProgress()), barH, { 100, 180, 255, 255 });
+
+    EndDrawing();
+}
+
+void GameWrapper::stepSimulation(float dt) {
+    PROFILE_SCOPE("stepSimulation");
+    for (auto& ent : mActiveEntities) {
+        if (ent && ent->mActive) ent->mPrevPosition = ent->mPosition;
+    }
 
-    handleInput(dt);
     updateEntities(dt);
     updateCollisions();
     updateLiquids(dt);
     updateCombat();
-    updateCamera(dt);
 
-    mCheats.update(dt);
-    mWeaponUI.update(dt);
+    if (mPlayerPtr && mPlayerPtr->mActive) mPlayerPtr->lateUpdate(dt);
 
-    drawWorld();
-    drawUI(windowWidth, windowHeight);
+    Input::ClearPressed();
 }
 
 void GameWrapper::handleInput(float dt) {
+    PROFILE_SCOPE("handleInput");
     if (IsKeyPressed(KEY_ESCAPE)) {
         saveGame();
         mState = 0;
         return;
     }
     if (IsKeyPressed(KEY_F3)) mShowDebug = !mShowDebug;
+    if (IsKeyPressed(KEY_F5)) hotReloadMap();
+    if (IsKeyPressed(KEY_F6)) toggleTileRenderer();
+    if (IsKeyPressed(KEY_F4)) {
+        size_t count = Profiler::get().dumpChromeTrace(TRACE_PATH);
+        mCheats.showMessage(TextFormat("TRACE: %d EVENTS", (int)count));
+    }
 
     if (mPlayerPtr) {
         bool weaponChanged = false;
@@ -437,8 +808,22 @@ void GameWrapper::handleInput(float dt) {
     }
     if (IsKeyPressed(KEY_R)) respawnAllBosses();
     if (IsKeyPressed(KEY_T)) {
-        if (mPlayerPtr && !mBosses.empty()) {
-            mPlayerPtr->mPosition = { mBosses[0]->mPosition.x - 60.0f, mBosses[0]->mPosition.y };
+        // Boss moe lee w niewczytanym chunku - wtedy bierzemy jego zapisan pozycj
+        Vector2 bossPos = { 0, 0 };
+        bool bossFound = !mBosses.empty();
+        if (bossFound) bossPos = mBosses[0]->mPosition;
+        else {
+            for (const auto& e : mStreamer.entityRecords()) {
+                if (e.entityType != MAGE_BOSS) continue;
+                bossPos = { (float)(e.x * TILE_SIZE_PX), (float)(e.y * TILE_SIZE_PX) };
+                bossFound = true;
+                break;
+            }
+        }
+
+        if (mPlayerPtr && bossFound) {
+            mPlayerPtr->mPosition = { bossPos.x - 60.0f, bossPos.y };
+            mPlayerPtr->mPrevPosition = mPlayerPtr->mPosition;
             mPlayerPtr->mVelocity = { 0,0 };
             mSmoothCamera.setPosition(mPlayerPtr->mPosition);
             mCheats.showMessage("TELEPORTED TO BOSS!");
@@ -467,6 +852,7 @@ void GameWrapper::handleInput(float dt) {
 }
 
 void GameWrapper::updateEntities(float dt) {
+    PROFILE_SCOPE("updateEntities");
     if (mPlayerPtr && mPlayerPtr->mActive) {
         mPlayerPtr->update(dt);
         if (mCheats.godMode) {
@@ -474,32 +860,37 @@ void GameWrapper::updateEntities(float dt) {
             mPlayerPtr->mInvincibilityTimer = 0.5f;
         }
     }
-    for (auto* b : mBosses) if (b && b->mActive) b->updateBossLogic(dt, mWallEntities);
+    for (auto* b : mBosses) if (b && b->mActive) b->updateBossLogic(dt, mTileGrid);
     for (auto* r : mRabbits) if (r && r->mActive) r->update(dt);
 }
 
 void GameWrapper::updateCollisions() {
+    PROFILE_SCOPE("updateCollisions");
     for (auto& ent : mActiveEntities) {
-        if (!ent || !ent->mActive || ent->mType == WALL) continue;
+        if (!ent || !ent->mActive) continue;
         if (mCheats.noclip && ent.get() == mPlayerPtr) continue;
 
-        mNearbyObstacles.clear();
-        mCollisionGrid.getNearby(ent->mPosition.x, ent->mPosition.y, mNearbyObstacles);
+        mNearbyWalls.clear();
+        mTileGrid.querySolids(ent->getRect(), mNearbyWalls);
 
-        for (Entity* obs : mNearbyObstacles) {
-            if (CheckCollisionRecs(ent->getRect(), obs->getRect())) {
-                ent->onCollision(obs);
+        for (const Rectangle& wallRect : mNearbyWalls) {
+            if (CheckCollisionRecs(ent->getRect(), wallRect)) {
+                ent->onWallCollision(wallRect);
             }
         }
     }
 }
 
 void GameWrapper::updateLiquids(float dt) {
+    PROFILE_SCOPE("updateLiquids");
     if (!mPlayerPtr || !mPlayerPtr->mActive) return;
     Rectangle pRect = mPlayerPtr->getRect();
 
-    for (const auto& liq : mLiquidRects) {
-        if (CheckCollisionRecs(pRect, { (float)liq.x, (float)liq.y, (float)liq.w, (float)liq.h })) {
+    mNearbyIds.clear();
+    mCollisionGrid.getNearby(pRect, mNearbyIds);
+
+    for (int id : mNearbyIds) {
+        if (CheckCollisionRecs(pRect, mLiquidRects[id])) {
             if (mPlayerPtr->mInvincibilityTimer <= 0) {
                 mPlayerPtr->mHealth -= 1;
                 mPlayerPtr->mInvincibilityTimer = 1.0f;
@@ -514,116 +905,234 @@ void GameWrapper::updateLiquids(float dt) {
     }
 }
 
+void GameWrapper::rebuildDynamicGrid() {
+    mDynamicBounds.clear();
+    mDynamicBodies.clear();
+
+    for (int i = 0; i < (int)mBosses.size(); i++) {
+        MageBoss* boss = mBosses[i];
+        if (!boss || !boss->mActive) continue;
+        mDynamicBounds.push_back(boss->getRect());
+        mDynamicBodies.push_back({ DynamicBody::BOSS, i, 0 });
+
+        for (int j = 0; j < (int)boss->mFireballs.size(); j++) {
+            const auto& fb = boss->mFireballs[j];
+            if (!fb.active) continue;
+            mDynamicBounds.push_back({ fb.position.x - fb.radius, fb.position.y - fb.radius, fb.radius * 2.0f, fb.radius * 2.0f });
+            mDynamicBodies.push_back({ DynamicBody::FIREBALL, i, j });
+        }
+    }
+
+    for (int i = 0; i < (int)mRabbits.size(); i++) {
+        RabbitEnemy* r = mRabbits[i];
+        if (!r || !r->mActive || r->mIsDead) continue;
+        mDynamicBounds.push_back(r->getRect());
+        mDynamicBodies.push_back({ DynamicBody::RABBIT, i, 0 });
+    }
+
+    mDynamicGrid.build(mDynamicBounds);
+}
+
 void GameWrapper::updateCombat() {
+    PROFILE_SCOPE("updateCombat");
     if (!mPlayerPtr || !mPlayerPtr->mActive) return;
+    rebuildDynamicGrid();
     Vector2 pc = Physics::GetEntityCenter(mPlayerPtr);
 
-    for (auto* boss : mBosses) {
-        if (!boss || !boss->mActive) continue;
-        if (mPlayerPtr->mIsAttacking && CheckCollisionRecs(mPlayerPtr->mAttackArea, boss->getRect())) {
-            if (!mPlayerPtr->hasHit(boss)) {
-                Vector2 ec = Physics::GetEntityCenter(boss);
-                mNearbyObstacles.clear();
-                mCollisionGrid.getNearby(pc.x, pc.y, mNearbyObstacles);
-                if (!Physics::IsPathBlocked(pc, ec, mNearbyObstacles)) {
-                    if (mPlayerPtr->mAttackDir == AttackDirection::DOWN) mPlayerPtr->pogoBounce();
-                    mPlayerPtr->mHitEntities.push_back(boss);
-                    boss->takeDamage(mPlayerPtr->getAttackDamage());
-                }
+    // Atak gracza
+    if (mPlayerPtr->mIsAttacking) {
+        mNearbyIds.clear();
+        mDynamicGrid.getNearby(mPlayerPtr->mAttackArea, mNearbyIds);
+
+        for (int id : mNearbyIds) {
+            const DynamicBody& body = mDynamicBodies[id];
+            if (body.kind == DynamicBody::FIREBALL) continue;
+
+            Entity* target = (body.kind == DynamicBody::BOSS) ? (Entity*)mBosses[body.index] : (Entity*)mRabbits[body.index];
+            if (!CheckCollisionRecs(mPlayerPtr->mAttackArea, target->getRect()) || mPlayerPtr->hasHit(target)) continue;
+
+            Vector2 ec = Physics::GetEntityCenter(target);
+            if (Physics::IsPathBlocked(pc, ec, mTileGrid)) continue;
+
+            if (mPlayerPtr->mAttackDir == AttackDirection::DOWN) mPlayerPtr->pogoBounce();
+            mPlayerPtr->mHitEntities.push_back(target);
+
+            if (body.kind == DynamicBody::BOSS) {
+                mBosses[body.index]->takeDamage(mPlayerPtr->getAttackDamage());
+            }
+            else {
+                RabbitEnemy* r = mRabbits[body.index];
+                r->takeDamage(mPlayerPtr->getAttackDamage());
+                if (r->mIsDead) r->mActive = false;
             }
         }
+    }
+
+    // Kontakt z przeciwnikami i pociskami
+    mNearbyIds.clear();
+    mDynamicGrid.getNearby(mPlayerPtr->getRect(), mNearbyIds);
 
-        // Zderzenie z bossem (obraenia)
-        if (boss->mState != MageBoss::VULNERABLE && boss->mState != MageBoss::DYING && boss->mState != MageBoss::INACTIVE) {
+    for (int id : mNearbyIds) {
+        const DynamicBody& body = mDynamicBodies[id];
+
+        if (body.kind == DynamicBody::BOSS) {
+            MageBoss* boss = mBosses[body.index];
+            if (boss->mState == MageBoss::VULNERABLE || boss->mState == MageBoss::DYING || boss->mState == MageBoss::INACTIVE) continue;
             if (CheckCollisionRecs(mPlayerPtr->getRect(), boss->getRect()) && mPlayerPtr->mInvincibilityTimer <= 0) {
                 mPlayerPtr->mHealth -= 1;
                 mPlayerPtr->mInvincibilityTimer = 1.0f;
 
-                AudioManager::getInstance()->playSound("hurt");
+                AudioManager::getInstance()->playSoundAt(mHurtSound, mPlayerPtr->mPosition);
                 float dir = Physics::GetKnockbackDirection(boss->mPosition.x, mPlayerPtr->mPosition.x);
                 Physics::ApplyKnockback(mPlayerPtr->mVelocity, dir, 120.0f, 80.0f);
             }
         }
-
-        if (mCheats.godMode) continue;
-
-        // Fireballs
-        for (auto& fb : boss->mFireballs) {
+        else if (body.kind == DynamicBody::FIREBALL) {
+            if (mCheats.godMode) continue;
+            auto& fb = mBosses[body.index]->mFireballs[body.sub];
             if (fb.active && mPlayerPtr->mInvincibilityTimer <= 0 && CheckCollisionCircleRec(fb.position, fb.radius, mPlayerPtr->getRect())) {
                 mPlayerPtr->mHealth -= 1;
                 mPlayerPtr->mInvincibilityTimer = 1.0f;
-                AudioManager::getInstance()->playSound("hurt");
+                AudioManager::getInstance()->playSoundAt(mHurtSound, mPlayerPtr->mPosition);
                 float dir = Physics::GetKnockbackDirection(fb.position.x, mPlayerPtr->mPosition.x);
                 Physics::ApplyKnockback(mPlayerPtr->mVelocity, dir, 150.0f, 100.0f);
                 fb.active = false;
             }
         }
-
-        // Laser
-        if (boss->mState == MageBoss::LASER_FIRE && mPlayerPtr->mInvincibilityTimer <= 0 && boss->checkLaserCollision(mPlayerPtr)) {
-            mPlayerPtr->mHealth -= 2;
-            mPlayerPtr->mInvincibilityTimer = 1.5f;
-            AudioManager::getInstance()->playSound("hurt");
-            float dir = Physics::GetKnockbackDirection(boss->mPosition.x, mPlayerPtr->mPosition.x);
-            Physics::ApplyKnockback(mPlayerPtr->mVelocity, dir, 200.0f, 150.0f);
-        }
-
-        // AOE
-        if (boss->checkAoeCollision(mPlayerPtr) && mPlayerPtr->mInvincibilityTimer <= 0) {
-            mPlayerPtr->mHealth -= 2;
-            mPlayerPtr->mInvincibilityTimer = 1.5f;
-            AudioManager::getInstance()->playSound("hurt");
-            float dx = mPlayerPtr->mPosition.x - boss->mPosition.x;
-            float dy = mPlayerPtr->mPosition.y - boss->mPosition.y;
-            float len = std::sqrt(dx * dx + dy * dy);
-            if (len > 0) {
-                mPlayerPtr->mVelocity.x = (dx / len) * 250.0f;
-                mPlayerPtr->mVelocity.y = (dy / len) * 250.0f - 100.0f;
+        else {
+            if (mCheats.godMode) continue;
+            RabbitEnemy* r = mRabbits[body.index];
+            if (!r->mIsDead && CheckCollisionRecs(mPlayerPtr->getRect(), r->getRect()) && mPlayerPtr->mInvincibilityTimer <= 0) {
+                int dmg = (r->mState >= RabbitEnemy::MONSTER_CHARGE && r->mState <= RabbitEnemy::MONSTER_TURN) ? 2 : 1;
+                mPlayerPtr->mHealth -= dmg;
+                mPlayerPtr->mInvincibilityTimer = 1.0f;
+                AudioManager::getInstance()->playSoundAt(mHurtSound, mPlayerPtr->mPosition);
+                float dir = Physics::GetKnockbackDirection(r->mPosition.x, mPlayerPtr->mPosition.x);
+                Physics::ApplyKnockback(mPlayerPtr->mVelocity, dir, 100.0f, 60.0f);
             }
-            boss->mAoeDealtDamage = true;
         }
     }
 
-    for (auto* r : mRabbits) {
-        if (!r || !r->mActive || r->mIsDead) continue;
-        if (mPlayerPtr->mIsAttacking && CheckCollisionRecs(mPlayerPtr->mAttackArea, r->getRect())) {
-            if (!mPlayerPtr->hasHit(r)) {
-                Vector2 ec = Physics::GetEntityCenter(r);
-                mNearbyObstacles.clear();
-                mCollisionGrid.getNearby(pc.x, pc.y, mNearbyObstacles);
-                if (!Physics::IsPathBlocked(pc, ec, mNearbyObstacles)) {
-                    if (mPlayerPtr->mAttackDir == AttackDirection::DOWN) mPlayerPtr->pogoBounce();
-                    mPlayerPtr->mHitEntities.push_back(r);
-                    r->takeDamage(mPlayerPtr->getAttackDamage());
-                    if (r->mIsDead) r->mActive = false;
+    // Laser i AOE nie maj prostokta - sprawdzane per boss
+    if (!mCheats.godMode) {
+        for (auto* boss : mBosses) {
+            if (!boss || !boss->mActive) continue;
+            // Laser
+            if (boss->mState == MageBoss::LASER_FIRE && mPlayerPtr->mInvincibilityTimer <= 0 && boss->checkLaserCollision(mPlayerPtr)) {
+                mPlayerPtr->mHealth -= 2;
+                mPlayerPtr->mInvincibilityTimer = 1.5f;
+                AudioManager::getInstance()->playSoundAt(mHurtSound, mPlayerPtr->mPosition);
+                float dir = Physics::GetKnockbackDirection(boss->mPosition.x, mPlayerPtr->mPosition.x);
+                Physics::ApplyKnockback(mPlayerPtr->mVelocity, dir, 200.0f, 150.0f);
+            }
+
+            // AOE
+            if (boss->checkAoeCollision(mPlayerPtr) && mPlayerPtr->mInvincibilityTimer <= 0) {
+                mPlayerPtr->mHealth -= 2;
+                mPlayerPtr->mInvincibilityTimer = 1.5f;
+                AudioManager::getInstance()->playSoundAt(mHurtSound, mPlayerPtr->mPosition);
+                float dx = mPlayerPtr->mPosition.x - boss->mPosition.x;
+                float dy = mPlayerPtr->mPosition.y - boss->mPosition.y;
+                float len = std::sqrt(dx * dx + dy * dy);
+                if (len > 0) {
+                    mPlayerPtr->mVelocity.x = (dx / len) * 250.0f;
+                    mPlayerPtr->mVelocity.y = (dy / len) * 250.0f - 100.0f;
                 }
+                boss->mAoeDealtDamage = true;
             }
         }
-        if (mCheats.godMode) continue;
-        if (!r->mIsDead && CheckCollisionRecs(mPlayerPtr->getRect(), r->getRect()) && mPlayerPtr->mInvincibilityTimer <= 0) {
-            int dmg = (r->mState >= RabbitEnemy::MONSTER_CHARGE && r->mState <= RabbitEnemy::MONSTER_TURN) ? 2 : 1;
-            mPlayerPtr->mHealth -= dmg;
-            mPlayerPtr->mInvincibilityTimer = 1.0f;
-            AudioManager::getInstance()->playSound("hurt");
-            float dir = Physics::GetKnockbackDirection(r->mPosition.x, mPlayerPtr->mPosition.x);
-            Physics::ApplyKnockback(mPlayerPtr->mVelocity, dir, 100.0f, 60.0f);
-        }
     }
 
     if (mPlayerPtr && mPlayerPtr->mHealth <= 0 && mPlayerPtr->mActive) {
-        AudioManager::getInstance()->playSound("death");
+        AudioManager::getInstance()->playSoundAt(mDeathSound, mPlayerPtr->mPosition);
     }
 }
 
 void GameWrapper::updateCamera(float dt) {
+    PROFILE_SCOPE("updateCamera");
     if (mPlayerPtr && mPlayerPtr->mActive) {
-        mPlayerPtr->lateUpdate(dt);
-        mSmoothCamera.update(mPlayerPtr->mPosition, dt);
+        mSmoothCamera.update(interpolatedPosition(mPlayerPtr), dt);
         mCamera.target = mSmoothCamera.getPosition();
     }
+    AudioManager::getInstance()->setListenerPosition(mSmoothCamera.getPosition());
+}
+
+Vector2 GameWrapper::interpolatedPosition(const Entity* e) const {
+    return {
+        e->mPrevPosition.x + (e->mPosition.x - e->mPrevPosition.x) * mRenderAlpha,
+        e->mPrevPosition.y + (e->mPosition.y - e->mPrevPosition.y) * mRenderAlpha
+    };
+}
+
+// Rysuje encj midzy dwoma ostatnimi krokami symulacji, nie ruszajc jej stanu
+void GameWrapper::drawInterpolated(Entity* e) {
+    Vector2 simPosition = e->mPosition;
+    e->mPosition = interpolatedPosition(e);
+    e->draw(mSpriteBatch);
+    e->mPosition = simPosition;
+}
+
+void GameWrapper::toggleTileRenderer() {
+    if (!mTileShader.isReady()) {
+        mCheats.showMessage("TILEMAP SHADER UNAVAILABLE");
+        return;
+    }
+    mUseTileShader = !mUseTileShader;
+    mCheats.showMessage(mUseTileShader ? "TILEMAP: SHADER" : "TILEMAP: CHUNKS");
+}
+
+// Jeden quad na wypieczony chunk warstwy; chunki czekajce na wypiekanie rysujemy kafelek po kafelku
+void GameWrapper::drawTileLayer(Layers layer, int camL, int camT, int camR, int camB) {
+    if (mUseTileShader) {
+        mTileShader.draw(layer, mTileset);
+        return;
+    }
+
+    for (int chunkY = tileToChunk(camT); chunkY <= tileToChunk(camB); ++chunkY) {
+        for (int chunkX = tileToChunk(camL); chunkX <= tileToChunk(camR); ++chunkX) {
+            const GameMap::Page* page = mGameMap.findPage(layer, chunkX, chunkY);
+            if (!page) continue;
+
+            const int originX = chunkX * GameMap::PAGE_SIZE;
+            const int originY = chunkY * GameMap::PAGE_SIZE;
+            Vector2 originPx = { (float)(originX * TILE_SIZE_PX), (float)(originY * TILE_SIZE_PX) };
+
+            if (const Texture2D* baked = mChunkCache.find(layer, makeChunkKey(chunkX, chunkY), page->revision)) {
+                const float size = (float)ChunkRenderCache::PAGE_PIXELS;
+                DrawTextureRec(*baked, { 0, 0, size, -size }, originPx, WHITE);
+                continue;
+            }
+
+            const int x0 = std::max(camL, originX) - originX, x1 = std::min(camR, originX + GameMap::PAGE_SIZE - 1) - originX;
+            const int y0 = std::max(camT, originY) - originY, y1 = std::min(camB, originY + GameMap::PAGE_SIZE - 1) - originY;
+            ChunkRenderCache::drawTiles(page->tiles.data(), mTileset, originPx, x0, y0, x1, y1);
+        }
+    }
 }
 
 void GameWrapper::drawWorld() {
+    PROFILE_SCOPE("drawWorld");
+
+    // Widoczne kafelki w bezwzgldnych wsprzdnych
+    int camL = CollisionGrid::toTile(mCamera.target.x - VIRTUAL_WIDTH / 2) - 1;
+    int camR = CollisionGrid::toTile(mCamera.target.x + VIRTUAL_WIDTH / 2) + 1;
+    int camT = CollisionGrid::toTile(mCamera.target.y - VIRTUAL_HEIGHT / 2) - 1;
+    int camB = CollisionGrid::toTile(mCamera.target.y + VIRTUAL_HEIGHT / 2) + 1;
+
+    // Wysyanie indeksw i wypiekanie chunkw musi si odby przed BeginTextureMode gwnego celu
+    if (mUseTileShader) {
+        for (int layer = 0; layer < LAYER_COUNT; ++layer) mTileShader.update(mGameMap, (Layers)layer, camL, camT);
+    }
+    mChunkCache.beginFrame();
+    for (int layer = 0; layer < LAYER_COUNT && !mUseTileShader; ++layer) {
+        for (int chunkY = tileToChunk(camT); chunkY <= tileToChunk(camB); ++chunkY) {
+            for (int chunkX = tileToChunk(camL); chunkX <= tileToChunk(camR); ++chunkX) {
+                const GameMap::Page* page = mGameMap.findPage((Layers)layer, chunkX, chunkY);
+                if (page) mChunkCache.prepare((Layers)layer, makeChunkKey(chunkX, chunkY), page->revision, page->tiles.data(), mTileset);
+            }
+        }
+    }
+
     BeginTextureMode(mRenderTarget);
     ClearBackground({ 2, 2, 5, 255 });
     DrawRectangleGradientV(0, 0, VIRTUAL_WIDTH, VIRTUAL_HEIGHT, { 0, 0, 0, 255 }, { 10, 15, 30, 255 });
@@ -636,29 +1145,26 @@ void GameWrapper::drawWorld() {
 
     BeginMode2D(mCamera);
 
-    int camL = (int)(mCamera.target.x - VIRTUAL_WIDTH / 2 - mGameMap.minX) / TILE_SIZE_PX - 1;
-    int camR = (int)(mCamera.target.x + VIRTUAL_WIDTH / 2 - mGameMap.minX) / TILE_SIZE_PX + 2;
-    int camT = (int)(mCamera.target.y - VIRTUAL_HEIGHT / 2 - mGameMap.minY) / TILE_SIZE_PX - 1;
-    int camB = (int)(mCamera.target.y + VIRTUAL_HEIGHT / 2 - mGameMap.minY) / TILE_SIZE_PX + 2;
-
-    for (int gy = std::max(0, camT); gy < std::min(mGameMap.height, camB); ++gy) {
-        for (int gx = std::max(0, camL); gx < std::min(mGameMap.width, camR); ++gx) {
-            int id = mGameMap.getTileAt(gx, gy);
-            if (id == 0) continue;
-            Rectangle src = { (float)(id % ATLAS_COLUMNS) * TILE_SIZE_PX, (float)(id / ATLAS_COLUMNS) * TILE_SIZE_PX, (float)TILE_SIZE_PX, (float)TILE_SIZE_PX };
-            DrawTextureRec(mTileset, src, { (float)(gx * TILE_SIZE_PX + mGameMap.minX), (float)(gy * TILE_SIZE_PX + mGameMap.minY) }, WHITE);
-        }
-    }
+    drawTileLayer(Layers::BACKGROUND, camL, camT, camR, camB);
+    drawTileLayer(Layers::MIDGROUND, camL, camT, camR, camB);
+
+    for (auto* r : mRabbits) if (r && r->mActive) drawInterpolated(r);
+    for (auto* b : mBosses) if (b && b->mActive) drawInterpolated(b);
+
+    if (mPlayerPtr && mPlayerPtr->mActive) drawInterpolated(mPlayerPtr);
 
-    for (auto* r : mRabbits) if (r && r->mActive) r->draw();
-    for (auto* b : mBosses) if (b && b->mActive) b->draw();
+    // Encje tylko kolejkuj sprite'y - rysujemy je posortowane po gbokoci i teksturze
+    mSpriteBatch.flush();
 
     if (mPlayerPtr && mPlayerPtr->mActive) {
-        mPlayerPtr->draw();
-        if (mCheats.godMode) DrawCircleLines((int)(mPlayerPtr->mPosition.x + 8), (int)(mPlayerPtr->mPosition.y + 8), 12, Fade(GOLD, 0.5f));
-        if (mCheats.noclip) DrawCircleLines((int)(mPlayerPtr->mPosition.x + 8), (int)(mPlayerPtr->mPosition.y + 8), 10, Fade(SKYBLUE, 0.6f));
+        Vector2 pp = interpolatedPosition(mPlayerPtr);
+        if (mCheats.godMode) DrawCircleLines((int)(pp.x + 8), (int)(pp.y + 8), 12, Fade(GOLD, 0.5f));
+        if (mCheats.noclip) DrawCircleLines((int)(pp.x + 8), (int)(pp.y + 8), 10, Fade(SKYBLUE, 0.6f));
     }
 
+    // Pierwszy plan zasania encje
+    drawTileLayer(Layers::FOREGROUND, camL, camT, camR, camB);
+
     if (mShowDebug) {
         if (mPlayerPtr) {
             DrawRectangleLinesEx(mPlayerPtr->getRect(), 1, GREEN);
@@ -673,6 +1179,7 @@ void GameWrapper::drawWorld() {
 }
 
 void GameWrapper::drawUI(int windowWidth, int windowHeight) {
+    PROFILE_SCOPE("drawUI");
     BeginDrawing();
     ClearBackground(BLACK);
 
@@ -776,11 +1283,13 @@ void GameWrapper::drawUI(int windowWidth, int windowHeight) {
         int dty = dy + 10;
         DrawText(TextFormat("FPS: %d", GetFPS()), dx + 10, dty, 10, LIME); dty += 15;
         DrawText(TextFormat("ENTITIES: %d", (int)mActiveEntities.size()), dx + 10, dty, 10, WHITE); dty += 15;
+        DrawText(TextFormat("SPRITES: %d  TEX: %d", (int)mSpriteBatch.commandCount(), (int)mSpriteBatch.textureSwitches()), dx + 10, dty, 10, WHITE); dty += 15;
         if (mPlayerPtr) DrawText(TextFormat("POS: %.0f, %.0f", mPlayerPtr->mPosition.x, mPlayerPtr->mPosition.y), dx + 10, dty, 10, WHITE); dty += 30;
 
         DrawText("CHEATS:", dx + 10, dty, 10, YELLOW); dty += 15;
         DrawText("GOD:", dx + 10, dty, 10, WHITE); DrawText(mCheats.godMode ? "ON" : "OFF", dx + 60, dty, 10, mCheats.godMode ? GOLD : RED); dty += 15;
-        DrawText("NOCLIP:", dx + 10, dty, 10, WHITE); DrawText(mCheats.noclip ? "ON" : "OFF", dx + 60, dty, 10, mCheats.noclip ? SKYBLUE : RED); dty += 30;
+        DrawText("NOCLIP:", dx + 10, dty, 10, WHITE); DrawText(mCheats.noclip ? "ON" : "OFF", dx + 60, dty, 10, mCheats.noclip ? SKYBLUE : RED); dty += 15;
+        DrawText("TILES:", dx + 10, dty, 10, WHITE); DrawText(mUseTileShader ? "SHADER" : "CHUNKS", dx + 60, dty, 10, LIME); dty += 30;
 
         DrawText("KEYS:", dx + 10, dty, 10, YELLOW); dty += 15;
         DrawText("[G] God Mode", dx + 10, dty, 10, GRAY); dty += 15;
@@ -789,6 +1298,7 @@ void GameWrapper::drawUI(int windowWidth, int windowHeight) {
         DrawText("[T] TP Boss", dx + 10, dty, 10, GRAY); dty += 15;
         DrawText("[K] Kill Boss", dx + 10, dty, 10, GRAY); dty += 15;
         DrawText("[R] Respawn", dx + 10, dty, 10, GRAY); dty += 15;
+        DrawText("[F6] Tilemap", dx + 10, dty, 10, GRAY); dty += 15;
         DrawText("[F1] Reset", dx + 10, dty, 10, GRAY);
     }
 
@@ -796,6 +1306,11 @@ void GameWrapper::drawUI(int windowWidth, int windowHeight) {
 }
 
 void GameWrapper::respawnAllBosses() {
+    const auto& records = mStreamer.entityRecords();
+    for (size_t i = 0; i < records.size() && i < mSpawnKilled.size(); i++) {
+        if (records[i].entityType == MAGE_BOSS) mSpawnKilled[i] = false;
+    }
+
     int bossIndex = 0;
     for (MageBoss* boss : mBosses) {
         if (boss && bossIndex < (int)mBossSpawnPoints.size()) {
@@ -842,6 +1357,7 @@ void GameWrapper::respawnAllBosses() {
 void GameWrapper::respawnPlayer() {
     if (mPlayerPtr) {
         mPlayerPtr->mPosition = mPlayerSpawnPoint;
+        mPlayerPtr->mPrevPosition = mPlayerSpawnPoint;
         mPlayerPtr->mVelocity = { 0, 0 };
         mPlayerPtr->mHealth = mPlayerPtr->mMaxHealth;
         mPlayerPtr->mInvincibilityTimer = 1.0f;
@@ -2,13 +2,23 @@
 
 #include "raylib.h"
 #include "GameConstants.hpp"
+#include "CollisionGrid.hpp"
+#include "ChunkStreamer.hpp"
+#include "ChunkRenderCache.hpp"
+#include "TilemapShader.hpp"
+#include "SpriteBatch.hpp"
 #include "../Map/map.hpp"
+#include "../Audio/AudioManager.hpp"
 
+#include <array>
 #include <vector>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <cmath>
 #include <algorithm>
+#include <unordered_map>
+#include <future>
 
 class Entity;
 class Player;
@@ -16,29 +26,85 @@ class MageBoss;
 class RabbitEnemy;
 class Saves;
 
+// Render tiles in CHUNK_SIZE x CHUNK_SIZE pages keyed by chunk, one page set per Layers value,
+// so memory follows the content instead of the bounding box and every layer draws on its own.
+// Tile coordinates are absolute (pixel / TILE_SIZE_PX).
 struct GameMap {
+    static constexpr int PAGE_SIZE = CHUNK_SIZE;
+
+    struct Page {
+        std::array<uint16_t, PAGE_SIZE * PAGE_SIZE> tiles{};
+        // Bumped on every change, so baked render caches know they are stale
+        uint32_t revision = 0;
+    };
+
+    using PageMap = std::unordered_map<ChunkKey, std::unique_ptr<Page>>;
+
+    std::array<PageMap, LAYER_COUNT> layers;
+    uint32_t nextRevision = 1;
+    // Bumped on any change, including removed pages, so map views can skip refreshing
+    uint32_t version = 0;
+
+    // Bounding box of all pages: top-left in pixels, size in tiles
     int width = 0;
     int height = 0;
     int minX = 0;
     int minY = 0;
-    std::vector<int> tiles;
 
     void init(const std::vector<struct RenderTile>& rawTiles);
-    int getTileAt(int gridX, int gridY) const;
+    void clear();
+    void addTiles(const std::vector<struct RenderTile>& rawTiles);
+    // Drops the chunk from every layer
+    void removePage(ChunkKey key);
+    const Page* findPage(Layers layer, int chunkX, int chunkY) const;
+    uint16_t getTileAt(int tileX, int tileY, Layers layer) const;
+    // Row-major w x h tile ids starting at (tileX, tileY); missing pages read as 0
+    void copyRegion(Layers layer, int tileX, int tileY, int w, int h, uint16_t* out) const;
+
+    // Layer values past FOREGROUND are drawn with the foreground
+    static int layerIndex(Layers layer);
+
+private:
+    void updateBounds();
 };
 
+// Static broadphase in CSR layout: items of cell i are cellItems[cellStart[i] .. cellStart[i + 1]).
+// Every item is stored in each cell its bounds overlap; ids index the array passed to build().
 struct SpatialGrid {
-    std::vector<std::vector<Entity*>> cells;
+    std::vector<int> cellStart;
+    std::vector<int> cellItems;
+    std::vector<Rectangle> bounds;
     int cellSize = 64;
     int width = 0;
     int height = 0;
     int offsetX = 0;
     int offsetY = 0;
 
+    mutable std::vector<uint32_t> queryStamps;
+    mutable uint32_t currentStamp = 0;
+    std::vector<int> cellCursor;
+
     void init(int mapW, int mapH, int minX, int minY);
     void clear();
-    void insertStatic(Entity* e);
-    void getNearby(float x, float y, std::vector<Entity*>& outResult) const;
+    void build(const std::vector<Rectangle>& rects);
+    void getNearby(Rectangle area, std::vector<int>& outIds) const;
+
+private:
+    void cellRange(Rectangle r, int& x0, int& y0, int& x1, int& y1) const;
+};
+
+// What a dynamic grid id refers to: mBosses[index], mRabbits[index] or mBosses[index]->mFireballs[sub].
+struct DynamicBody {
+    enum Kind : uint8_t { BOSS, RABBIT, FIREBALL };
+    Kind kind;
+    int index;
+    int sub;
+};
+
+// Entity created from entityRecords()[record] of the streamed chunk it spawned in.
+struct StreamedEntity {
+    size_t record;
+    Entity* entity;
 };
 
 struct SmoothCamera {
@@ -84,9 +150,17 @@ public:
     ~GameWrapper();
 
     void runFrame(int windowWidth, int windowHeight);
+    // Input, fixed-step simulation and camera for one frame, without drawing
+    void updateFrame(float frameTime);
+    void drawFrame(int windowWidth, int windowHeight);
     void reset();
+    // Clears the world and loads the current slot again behind the loading screen
     void reloadSave();
 
+    bool isLoading() const { return mLoading; }
+    // Blocks until the pending load is done (headless runs have no frames to spread it over)
+    void finishLoading();
+
 private:
     bool& mShouldQuit;
     int& mState;
@@ -101,39 +175,86 @@ private:
     Camera2D mCamera;
 
     GameMap mGameMap;
+    ChunkRenderCache mChunkCache;
+    TilemapShader mTileShader;
+    bool mUseTileShader = GameConstants::TILEMAP_SHADER_DEFAULT;
+    SpriteBatch mSpriteBatch;
+    CollisionGrid mTileGrid;
     SpatialGrid mCollisionGrid;
+    SpatialGrid mDynamicGrid;
     SmoothCamera mSmoothCamera;
     CheatSystem mCheats;
     WeaponUIState mWeaponUI;
 
     std::vector<std::unique_ptr<Entity>> mActiveEntities;
-    std::vector<Entity*> mWallEntities;
     Player* mPlayerPtr = nullptr;
     std::vector<MageBoss*> mBosses;
     std::vector<RabbitEnemy*> mRabbits;
+    // Parallel to mBosses
     std::vector<BossSpawnData> mBossSpawnPoints;
 
-    std::vector<Entity*> mNearbyObstacles;
-    std::vector<CollisionRect> mLiquidRects;
+    ChunkStreamer mStreamer;
+    std::unordered_map<ChunkKey, std::vector<StreamedEntity>> mChunkEntities;
+    std::vector<bool> mSpawnKilled;
+
+    std::vector<Rectangle> mNearbyWalls;
+    std::vector<Rectangle> mLiquidRects;
+    std::vector<int> mNearbyIds;
+    std::vector<Rectangle> mDynamicBounds;
+    std::vector<DynamicBody> mDynamicBodies;
 
     Vector2 mPlayerSpawnPoint = { 464.5f, 442.0f };
     bool mShowDebug = false;
     bool mInitialized = false;
+    unsigned int mTextureGeneration = 0; // AssetCache::textureGeneration() as of the last loadTextures()
+
+    // Editor import runs on the thread pool while AssetCache decodes textures and sounds
+    bool mLoading = false;
+    std::future<void> mImportTask;
+    size_t mLoadTotal = 0;
+
+    float mSimAccumulator = 0.0f;
+    float mRenderAlpha = 1.0f;
+
+    void beginLoading();
+    // One frame of upload work; true once the load completed
+    bool updateLoading();
+    void completeLoading();
+    float loadProgress() const;
+    void drawLoadingScreen(int windowWidth, int windowHeight);
 
     void loadTextures();
     void unloadTextures();
     void loadMap();
+    void applyMapData(const MapData& mapData);
+    void rebuildCollisionData(const MapData& mapData);
     void loadEntities();
+    Entity* spawnEntity(const EntityS& record);
+    void removeEntity(Entity* entity);
     void createTestEnemies();
 
+    void updateStreaming();
+    // Re-imports chunks changed in the editor and swaps their tiles and collisions in place
+    void hotReloadMap();
+    void spawnChunkEntities(ChunkKey key);
+    void despawnChunkEntities(ChunkKey key);
+
     void handleInput(float dt);
+    void stepSimulation(float dt);
     void updateEntities(float dt);
     void updateCollisions();
     void updateLiquids(float dt);
+    void rebuildDynamicGrid();
     void updateCombat();
     void updateCamera(float dt);
 
+    Vector2 interpolatedPosition(const Entity* e) const;
+    void drawInterpolated(Entity* e);
     void drawWorld();
+    // Switches between baked chunks and the tilemap shader (F6)
+    void toggleTileRenderer();
+    // Visible chunks of one tile layer; camL..camB are absolute tile bounds
+    void drawTileLayer(Layers layer, int camL, int camT, int camR, int camB);
     void drawUI(int windowWidth, int windowHeight);
 
     void respawnAllBosses();
@@ -141,7 +262,7 @@ private:
 
     void saveGame();
     
-    int mCurrentMusicTrack = 1; // 1 = Abyss, 2 = Abyss_deep
-    void updateBackgroundMusic();
+    SoundHandle mHurtSound = INVALID_SOUND;
+    SoundHandle mDeathSound = INVALID_SOUND;
     void loadAudio();
 };
\ No newline at end of file
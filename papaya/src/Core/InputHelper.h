@@ -2,6 +2,28 @@
 #include "raylib.h"
 
 namespace Input {
+    // Presses are latched every rendered frame and cleared after the simulation step
+    // that saw them, so a fixed timestep neither drops nor repeats them.
+    struct PressedState {
+        bool jump = false;
+        bool dash = false;
+        bool attack = false;
+        bool sacrifice = false;
+    };
+
+    inline PressedState gPressed;
+
+    inline void LatchPressed() {
+        gPressed.jump |= IsKeyPressed(KEY_SPACE);
+        gPressed.dash |= IsKeyPressed(KEY_C);
+        gPressed.attack |= IsKeyPressed(KEY_Z);
+        gPressed.sacrifice |= IsKeyPressed(KEY_H);
+    }
+
+    inline void ClearPressed() {
+        gPressed = {};
+    }
+
     inline bool IsMovingRight() {
         return IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D);
     }
@@ -33,7 +55,7 @@ namespace Input {
     }
 
     inline bool JumpPressed() {
-        return IsKeyPressed(KEY_SPACE);
+        return gPressed.jump;
     }
 
     inline bool JumpHeld() {
@@ -41,14 +63,14 @@ namespace Input {
     }
 
     inline bool DashPressed() {
-        return IsKeyPressed(KEY_C);
+        return gPressed.dash;
     }
 
     inline bool AttackPressed() {
-        return IsKeyPressed(KEY_Z);
+        return gPressed.attack;
     }
 
     inline bool SacrificePressed() {
-        return IsKeyPressed(KEY_H);
+        return gPressed.sacrifice;
     }
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "raylib.h"
+#include "CollisionGrid.hpp"
+#include <cmath>
 #include <vector>
 
 namespace Physics {
@@ -22,20 +24,70 @@ namespace Physics {
         return false;
     }
 
-    template<typename T>
-    inline bool IsPathBlocked(Vector2 start, Vector2 end, const std::vector<T*>& walls) {
-        for (const auto* wall : walls) {
-            Rectangle wallRect = {
-                wall->mPosition.x,
-                wall->mPosition.y,
-                wall->mSize.x,
-                wall->mSize.y
-            };
-            if (CheckCollisionLineRec(start, end, wallRect)) {
-                return true;
+    struct RayHit {
+        bool hit = false;
+        Vector2 point = { 0, 0 };
+        float distance = 0.0f;
+    };
+
+    // Grid traversal (Amanatides & Woo): visits every tile the ray crosses, in order,
+    // and returns the point where it first enters a solid one. `dir` must be normalized.
+    inline RayHit RaycastTiles(Vector2 origin, Vector2 dir, float maxDist, const CollisionGrid& tiles) {
+        RayHit result;
+        int tileX = CollisionGrid::toTile(origin.x);
+        int tileY = CollisionGrid::toTile(origin.y);
+
+        if (tiles.isSolidTile(tileX, tileY)) {
+            result.hit = true;
+            result.point = origin;
+            return result;
+        }
+
+        const float inf = INFINITY;
+        int stepX = (dir.x > 0) ? 1 : (dir.x < 0) ? -1 : 0;
+        int stepY = (dir.y > 0) ? 1 : (dir.y < 0) ? -1 : 0;
+        float tDeltaX = (stepX != 0) ? TILE_SIZE / fabsf(dir.x) : inf;
+        float tDeltaY = (stepY != 0) ? TILE_SIZE / fabsf(dir.y) : inf;
+        float tMaxX = (stepX > 0) ? ((tileX + 1) * TILE_SIZE - origin.x) / dir.x
+                    : (stepX < 0) ? (tileX * TILE_SIZE - origin.x) / dir.x : inf;
+        float tMaxY = (stepY > 0) ? ((tileY + 1) * TILE_SIZE - origin.y) / dir.y
+                    : (stepY < 0) ? (tileY * TILE_SIZE - origin.y) / dir.y : inf;
+
+        while (true) {
+            float t;
+            if (tMaxX < tMaxY) {
+                t = tMaxX;
+                tileX += stepX;
+                tMaxX += tDeltaX;
+            }
+            else {
+                t = tMaxY;
+                tileY += stepY;
+                tMaxY += tDeltaY;
+            }
+
+            if (t > maxDist) break;
+
+            if (tiles.isSolidTile(tileX, tileY)) {
+                result.hit = true;
+                result.distance = t;
+                result.point = { origin.x + dir.x * t, origin.y + dir.y * t };
+                return result;
             }
         }
-        return false;
+
+        result.distance = maxDist;
+        result.point = { origin.x + dir.x * maxDist, origin.y + dir.y * maxDist };
+        return result;
+    }
+
+    inline bool IsPathBlocked(Vector2 start, Vector2 end, const CollisionGrid& tiles) {
+        float dx = end.x - start.x;
+        float dy = end.y - start.y;
+        float length = sqrtf(dx * dx + dy * dy);
+        if (length <= 0.0f) return tiles.isSolidAt(start.x, start.y);
+
+        return RaycastTiles(start, { dx / length, dy / length }, length, tiles).hit;
     }
 
     template<typename T>
@@ -0,0 +1,88 @@
+#include "Profiler.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace {
+    std::atomic<uint32_t> gNextThreadId{ 1 };
+
+    uint32_t currentThreadId() {
+        thread_local uint32_t id = gNextThreadId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    struct TraceEvent {
+        const char* name;
+        uint64_t startNs;
+        uint64_t durationNs;
+        uint32_t threadId;
+    };
+}
+
+Profiler& Profiler::get() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() : mEpoch(std::chrono::steady_clock::now()), mSlots(new Slot[CAPACITY]) {}
+
+uint64_t Profiler::nowNs() const {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mEpoch).count();
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    uint64_t index = mWriteIndex.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = mSlots[index & (CAPACITY - 1)];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(endNs - startNs, std::memory_order_relaxed);
+    slot.threadId.store(currentThreadId(), std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+size_t Profiler::dumpChromeTrace(const std::string& path) const {
+    uint64_t end = mWriteIndex.load(std::memory_order_acquire);
+    uint64_t begin = (end > CAPACITY) ? end - CAPACITY : 0;
+
+    std::vector<TraceEvent> events;
+    events.reserve((size_t)(end - begin));
+
+    for (uint64_t i = begin; i < end; i++) {
+        const Slot& slot = mSlots[i & (CAPACITY - 1)];
+        uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before != 2 * i + 2) continue;
+
+        TraceEvent ev = {
+            slot.name.load(std::memory_order_relaxed),
+            slot.startNs.load(std::memory_order_relaxed),
+            slot.durationNs.load(std::memory_order_relaxed),
+            slot.threadId.load(std::memory_order_relaxed)
+        };
+
+        // Slot nadpisany w trakcie odczytu - pomijamy
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) continue;
+        events.push_back(ev);
+    }
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return 0;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    char line[256];
+    for (size_t i = 0; i < events.size(); i++) {
+        const TraceEvent& ev = events[i];
+        std::snprintf(line, sizeof(line),
+            "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+            ev.name ? ev.name : "?", ev.threadId, ev.startNs / 1000.0, ev.durationNs / 1000.0,
+            (i + 1 < events.size()) ? "," : "");
+        out << line;
+    }
+    out << "]}\n";
+
+    return events.size();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Scoped timings collected into a fixed-size lock-free ring buffer (oldest events are
+// overwritten) and exported as Chrome/Perfetto trace JSON. Event names must be string literals.
+class Profiler {
+public:
+    static constexpr uint32_t CAPACITY = 1u << 16;
+
+    static Profiler& get();
+
+    uint64_t nowNs() const;
+    void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Writes every event still in the buffer; returns the number of events written.
+    size_t dumpChromeTrace(const std::string& path) const;
+
+private:
+    struct Slot {
+        // 2*i+1 while event i is being written, 2*i+2 once it is complete
+        std::atomic<uint64_t> sequence{ 0 };
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<uint64_t> startNs{ 0 };
+        std::atomic<uint64_t> durationNs{ 0 };
+        std::atomic<uint32_t> threadId{ 0 };
+    };
+
+    Profiler();
+
+    std::chrono::steady_clock::time_point mEpoch;
+    std::atomic<uint64_t> mWriteIndex{ 0 };
+    Slot* mSlots;
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : mName(name), mStartNs(Profiler::get().nowNs()) {}
+    ~ProfileScope() { Profiler::get().record(mName, mStartNs, Profiler::get().nowNs()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* mName;
+    uint64_t mStartNs;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
@@ -0,0 +1,72 @@
+#include "SpriteBatch.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void SpriteBatch::texture(SpriteDepth depth, Texture2D texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+    if (texture.id == 0) return;
+    mCommands.push_back({ Kind::TEXTURE, depth, texture.id, texture, src, dest, origin, { 0, 0 }, rotation, tint });
+}
+
+void SpriteBatch::texture(SpriteDepth depth, Texture2D texture, Rectangle src, Vector2 position, Color tint) {
+    // Jak w DrawTextureRec: ujemna szerokość źródła odbija sprite, cel ma wymiary bez znaku
+    Rectangle dest = { position.x, position.y, std::abs(src.width), std::abs(src.height) };
+    this->texture(depth, texture, src, dest, { 0, 0 }, 0.0f, tint);
+}
+
+void SpriteBatch::rectangle(SpriteDepth depth, Rectangle rect, Color color) {
+    mCommands.push_back({ Kind::RECTANGLE, depth, 0, {}, {}, rect, { 0, 0 }, { 0, 0 }, 0.0f, color });
+}
+
+void SpriteBatch::circle(SpriteDepth depth, Vector2 center, float radius, Color color) {
+    mCommands.push_back({ Kind::CIRCLE, depth, 0, {}, {}, {}, center, { 0, 0 }, radius, color });
+}
+
+void SpriteBatch::circleLines(SpriteDepth depth, Vector2 center, float radius, Color color) {
+    mCommands.push_back({ Kind::CIRCLE_LINES, depth, 0, {}, {}, {}, center, { 0, 0 }, radius, color });
+}
+
+void SpriteBatch::line(SpriteDepth depth, Vector2 start, Vector2 end, float thickness, Color color) {
+    mCommands.push_back({ Kind::LINE, depth, 0, {}, {}, {}, start, end, thickness, color });
+}
+
+void SpriteBatch::flush() {
+    PROFILE_SCOPE("SpriteBatch::flush");
+
+    std::stable_sort(mCommands.begin(), mCommands.end(), [](const Command& a, const Command& b) {
+        if (a.depth != b.depth) return a.depth < b.depth;
+        return a.textureId < b.textureId;
+        });
+
+    size_t switches = 0;
+    unsigned int boundTexture = UINT32_MAX;
+    for (const Command& c : mCommands) {
+        if (c.textureId != boundTexture) {
+            boundTexture = c.textureId;
+            switches++;
+        }
+
+        switch (c.kind) {
+        case Kind::TEXTURE:
+            DrawTexturePro(c.texture, c.src, c.dest, c.origin, c.value, c.tint);
+            break;
+        case Kind::RECTANGLE:
+            DrawRectangleRec(c.dest, c.tint);
+            break;
+        case Kind::CIRCLE:
+            DrawCircleV(c.origin, c.value, c.tint);
+            break;
+        case Kind::CIRCLE_LINES:
+            DrawCircleLinesV(c.origin, c.value, c.tint);
+            break;
+        case Kind::LINE:
+            DrawLineEx(c.origin, c.end, c.value, c.tint);
+            break;
+        }
+    }
+
+    mLastCommands = mCommands.size();
+    mLastSwitches = switches;
+    mCommands.clear();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "raylib.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Draw order between groups of world sprites; commands inside one depth may be reordered
+// by texture, so anything that has to cover something else goes to a higher depth.
+enum class SpriteDepth : uint8_t {
+    ENEMIES = 0,      // rabbits and dummies
+    BOSS_SHOTS = 1,   // fireballs with their glows, AOE telegraph
+    BOSS_FX = 2,      // laser and AOE explosion, over every enemy and fireball
+    BOSS = 3,         // boss body over the rabbits, whatever texture ids GL handed out
+    PLAYER_TRAIL = 4, // dash ghosts, over enemies like the player they trail
+    PLAYER_FX = 5,    // wings and slashes, under the player body
+    PLAYER = 6,
+    OVERLAY = 7       // bars above characters
+};
+
+// Entities submit their sprites and shapes here instead of drawing right away. flush() sorts
+// the queue by depth and texture, keeping submission order otherwise, so raylib's batch only
+// breaks once per texture per depth instead of once per entity.
+class SpriteBatch {
+public:
+    SpriteBatch() = default;
+    ~SpriteBatch() = default;
+
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    // Same arguments as DrawTexturePro / DrawTextureRec
+    void texture(SpriteDepth depth, Texture2D texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation, Color tint);
+    void texture(SpriteDepth depth, Texture2D texture, Rectangle src, Vector2 position, Color tint);
+
+    // Shapes share raylib's shapes texture, so they batch together like one more texture
+    void rectangle(SpriteDepth depth, Rectangle rect, Color color);
+    void circle(SpriteDepth depth, Vector2 center, float radius, Color color);
+    void circleLines(SpriteDepth depth, Vector2 center, float radius, Color color);
+    void line(SpriteDepth depth, Vector2 start, Vector2 end, float thickness, Color color);
+
+    // Draws and clears the queue; must be called inside BeginMode2D
+    void flush();
+
+    size_t commandCount() const { return mLastCommands; }
+    // Texture changes in the last flush, the lower bound of raylib draw calls for the sprites
+    size_t textureSwitches() const { return mLastSwitches; }
+
+private:
+    enum class Kind : uint8_t { TEXTURE, RECTANGLE, CIRCLE, CIRCLE_LINES, LINE };
+
+    struct Command {
+        Kind kind;
+        SpriteDepth depth;
+        // 0 for shapes, which sorts them before every real texture in the depth
+        unsigned int textureId;
+        Texture2D texture;
+        Rectangle src;
+        Rectangle dest;
+        Vector2 origin;    // sprite pivot, circle center or line start
+        Vector2 end;       // line end
+        float value;       // sprite rotation, circle radius or line thickness
+        Color tint;
+    };
+
+    std::vector<Command> mCommands;
+    size_t mLastCommands = 0;
+    size_t mLastSwitches = 0;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Fixed-size ring buffer for exactly one producer thread and one consumer thread. Neither side
+// locks or allocates, so the audio thread can drain it without ever waiting on the main thread.
+template<typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() = default;
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side; false when the queue is full
+    bool push(const T& item) {
+        const size_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) == Capacity) return false;
+
+        mItems[tail & (Capacity - 1)] = item;
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; false when the queue is empty
+    bool pop(T& item) {
+        const size_t head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire)) return false;
+
+        item = mItems[head & (Capacity - 1)];
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> mItems{};
+    // Separate cache lines, so the two threads do not fight over one line on every push/pop
+    alignas(64) std::atomic<size_t> mHead{ 0 };
+    alignas(64) std::atomic<size_t> mTail{ 0 };
+};
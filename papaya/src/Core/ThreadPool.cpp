@@ -0,0 +1,39 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int workerCount) {
+    workerCount = std::max(1u, workerCount);
+    mWorkers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; i++) {
+        mWorkers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWakeUp.notify_all();
+    for (auto& worker : mWorkers) worker.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeUp.wait(lock, [this] { return mStopping || !mTasks.empty(); });
+            if (mStopping && mTasks.empty()) return;
+            task = std::move(mTasks.front());
+            mTasks.pop_front();
+        }
+        task();
+    }
+}
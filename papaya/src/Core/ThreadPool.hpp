@@ -0,0 +1,48 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads draining a FIFO task queue.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned int workerCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Shared pool sized to the machine, one core left for the main thread.
+    static ThreadPool& shared();
+
+    unsigned int size() const { return (unsigned int)mWorkers.size(); }
+
+    template<typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<F>> {
+        using Result = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTasks.emplace_back([packaged]() { (*packaged)(); });
+        }
+        mWakeUp.notify_one();
+        return future;
+    }
+
+private:
+    std::vector<std::thread> mWorkers;
+    std::deque<std::function<void()>> mTasks;
+    std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    bool mStopping = false;
+
+    void workerLoop();
+};
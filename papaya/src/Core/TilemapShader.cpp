@@ -0,0 +1,86 @@
+#include "TilemapShader.hpp"
+#include "GameWrapper.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace GameConstants;
+
+bool TilemapShader::load(const char* fragmentPath) {
+    unload();
+
+    // Domyślny vertex shader raylib wystarczy - quad i tak ma zwykłe UV 0..1
+    mShader = LoadShader(nullptr, fragmentPath);
+    mAtlasLoc = GetShaderLocation(mShader, "atlas");
+    mMapSizeLoc = GetShaderLocation(mShader, "mapSize");
+    mAtlasColumnsLoc = GetShaderLocation(mShader, "atlasColumns");
+    mTileSizeLoc = GetShaderLocation(mShader, "tileSize");
+
+    // Przy błędzie kompilacji raylib podstawia domyślny shader, który nie ma naszych uniformów
+    if (!IsShaderValid(mShader) || mAtlasLoc < 0 || mMapSizeLoc < 0) {
+        std::cout << "[TILEMAP] Shader " << fragmentPath << " niedostępny, zostają wypieczone chunki" << std::endl;
+        unload();
+        return false;
+    }
+
+    const int columns = ATLAS_COLUMNS;
+    const int tileSize = TILE_SIZE_PX;
+    SetShaderValue(mShader, mAtlasColumnsLoc, &columns, SHADER_UNIFORM_INT);
+    SetShaderValue(mShader, mTileSizeLoc, &tileSize, SHADER_UNIFORM_INT);
+
+    // Jeden teksel GRAY_ALPHA na kafelek: uint16_t id trafia wprost do dwóch bajtów teksela
+    mStaging.assign(WINDOW_W * WINDOW_H, 0);
+    for (auto& window : mLayers) {
+        Image image = { mStaging.data(), WINDOW_W, WINDOW_H, 1, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA };
+        window.indices = LoadTextureFromImage(image);
+        SetTextureFilter(window.indices, TEXTURE_FILTER_POINT);
+        SetTextureWrap(window.indices, TEXTURE_WRAP_CLAMP);
+    }
+
+    mReady = true;
+    return true;
+}
+
+void TilemapShader::unload() {
+    for (auto& window : mLayers) {
+        if (window.indices.id > 0) UnloadTexture(window.indices);
+        window = LayerWindow{};
+    }
+    if (mShader.id > 0) UnloadShader(mShader);
+    mShader = {};
+    mReady = false;
+}
+
+void TilemapShader::update(const GameMap& map, Layers layer, int originX, int originY) {
+    if (!mReady) return;
+
+    LayerWindow& window = mLayers[(int)layer];
+    if (window.uploaded && window.originX == originX && window.originY == originY && window.mapVersion == map.version) return;
+
+    PROFILE_SCOPE("TilemapShader::upload");
+    map.copyRegion(layer, originX, originY, WINDOW_W, WINDOW_H, mStaging.data());
+    UpdateTexture(window.indices, mStaging.data());
+
+    window.originX = originX;
+    window.originY = originY;
+    window.mapVersion = map.version;
+    window.uploaded = true;
+    window.empty = std::all_of(mStaging.begin(), mStaging.end(), [](uint16_t id) { return id == 0; });
+}
+
+void TilemapShader::draw(Layers layer, Texture2D tileset) {
+    const LayerWindow& window = mLayers[(int)layer];
+    if (!mReady || !window.uploaded || window.empty) return;
+
+    const Vector2 mapSize = { (float)WINDOW_W, (float)WINDOW_H };
+    const Rectangle src = { 0, 0, (float)WINDOW_W, (float)WINDOW_H };
+    const Rectangle dest = { (float)(window.originX * TILE_SIZE_PX), (float)(window.originY * TILE_SIZE_PX),
+        (float)(WINDOW_W * TILE_SIZE_PX), (float)(WINDOW_H * TILE_SIZE_PX) };
+
+    BeginShaderMode(mShader);
+    SetShaderValue(mShader, mMapSizeLoc, &mapSize, SHADER_UNIFORM_VEC2);
+    SetShaderValueTexture(mShader, mAtlasLoc, tileset);
+    DrawTexturePro(window.indices, src, dest, { 0, 0 }, 0.0f, WHITE);
+    EndShaderMode();
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "raylib.h"
+#include "GameConstants.hpp"
+#include "../Map/map.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+struct GameMap;
+
+// Alternative to ChunkRenderCache: the visible window of every tile layer is kept in a small
+// tile-index texture and a fragment shader looks the tiles up in the atlas, so a layer costs
+// one quad no matter how many tiles are on screen. The index texture is only re-uploaded when
+// the window moves by a tile or the map changes.
+class TilemapShader {
+public:
+    // Visible tiles plus the one-tile margin drawWorld() culls with, rounded up
+    static constexpr int WINDOW_W = GameConstants::VIRTUAL_WIDTH / GameConstants::TILE_SIZE_PX + 4;
+    static constexpr int WINDOW_H = GameConstants::VIRTUAL_HEIGHT / GameConstants::TILE_SIZE_PX + 4;
+
+    TilemapShader() = default;
+    ~TilemapShader() = default;
+
+    TilemapShader(const TilemapShader&) = delete;
+    TilemapShader& operator=(const TilemapShader&) = delete;
+
+    // False when the shader did not compile; the caller stays on the baked chunk path
+    bool load(const char* fragmentPath);
+    void unload();
+    bool isReady() const { return mReady; }
+
+    // Refreshes the layer's index texture for the window starting at tile (originX, originY)
+    void update(const GameMap& map, Layers layer, int originX, int originY);
+    // One quad covering the layer window; must be called inside BeginMode2D
+    void draw(Layers layer, Texture2D tileset);
+
+private:
+    struct LayerWindow {
+        Texture2D indices = {};
+        int originX = 0;
+        int originY = 0;
+        uint32_t mapVersion = 0;
+        bool uploaded = false;
+        bool empty = true;
+    };
+
+    Shader mShader = {};
+    int mAtlasLoc = -1;
+    int mMapSizeLoc = -1;
+    int mAtlasColumnsLoc = -1;
+    int mTileSizeLoc = -1;
+    bool mReady = false;
+
+    std::array<LayerWindow, LAYER_COUNT> mLayers;
+    std::vector<uint16_t> mStaging;
+};
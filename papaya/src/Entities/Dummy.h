@@ -21,9 +21,9 @@ public:
         return { mPosition.x, mPosition.y, 16, 32 };
     }
 
-    void draw() override {
+    void draw(SpriteBatch& batch) override {
         Color color = mIsHit ? RED : GREEN;
-        DrawRectangleRec(getRect(), color);
+        batch.rectangle(SpriteDepth::ENEMIES, getRect(), color);
     }
 
     void takeDamage() {
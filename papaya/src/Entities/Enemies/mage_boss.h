@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include "../Entity.h"
 #include "../Player/Player.h"
+#include "Core/CollisionGrid.hpp"
+#include "Core/Physics.hpp"
 #include "raylib.h"
 #include <vector>
 #include <cmath>
@@ -120,7 +122,6 @@ public:
     int mDeathFrameEnd = 20;
     float mActivationDistance = 150.0f;
 
-    Vector2 mPrevPosition = { 0, 0 };
     int mAttackCounter = 0;
     bool mTeleportAttack = false;
 
@@ -191,7 +192,7 @@ public:
         }
     }
 
-    Vector2 chooseTeleportDestination(const std::vector<Entity*>& walls) {
+    Vector2 chooseTeleportDestination(const CollisionGrid& tiles) {
         for (int attempt = 0; attempt < 8; attempt++) {
             Vector2 candidate = mPosition;
 
@@ -213,15 +214,7 @@ public:
             }
 
             Rectangle candidateRect = { candidate.x, candidate.y, mSize.x, mSize.y };
-            bool valid = true;
-
-            for (const auto* wall : walls) {
-                Rectangle wallRect = { wall->mPosition.x, wall->mPosition.y, wall->mSize.x, wall->mSize.y };
-                if (CheckCollisionRecs(candidateRect, wallRect)) {
-                    valid = false;
-                    break;
-                }
-            }
+            bool valid = tiles.isAreaFree(candidateRect);
 
             if (valid && pTarget) {
                 float dx = candidate.x - pTarget->mPosition.x;
@@ -235,7 +228,7 @@ public:
         return mPosition;
     }
 
-    void updateBossLogic(float deltaTime, std::vector<Entity*>& walls) {
+    void updateBossLogic(float deltaTime, const CollisionGrid& tiles) {
         if (!mActive) return;
 
         mUpdateCounter++;
@@ -265,12 +258,12 @@ public:
         mPosition.x += mVelocity.x * deltaTime;
         if (mHurtTimer > 0) mHurtTimer -= deltaTime;
 
-        updateFireballs(deltaTime, walls);
-        updateStateMachine(deltaTime, walls);
+        updateFireballs(deltaTime, tiles);
+        updateStateMachine(deltaTime, tiles);
         updateAnimation(deltaTime);
     }
 
-    void updateFireballs(float deltaTime, std::vector<Entity*>& walls) {
+    void updateFireballs(float deltaTime, const CollisionGrid& tiles) {
         for (int i = (int)mFireballs.size() - 1; i >= 0; i--) {
             Fireball& fb = mFireballs[i];
             if (!fb.active) {
@@ -298,14 +291,8 @@ public:
                 checkCollision = false;
             }
 
-            if (checkCollision) {
-                for (auto* wall : walls) {
-                    Rectangle wallRect = { wall->mPosition.x, wall->mPosition.y, wall->mSize.x, wall->mSize.y };
-                    if (CheckCollisionCircleRec(fb.position, fb.radius, wallRect)) {
-                        fb.active = false;
-                        break;
-                    }
-                }
+            if (checkCollision && tiles.overlapsCircle(fb.position, fb.radius)) {
+                fb.active = false;
             }
 
             if (distSqFromBoss > 1000000.0f) {
@@ -314,7 +301,7 @@ public:
         }
     }
 
-    void updateStateMachine(float deltaTime, std::vector<Entity*>& walls) {
+    void updateStateMachine(float deltaTime, const CollisionGrid& tiles) {
         switch (mState) {
         case INACTIVE:
             mVelocity = { 0, 0 };
@@ -345,7 +332,7 @@ public:
         case LASER_CHARGE:
             mStateTimer += deltaTime;
             mVelocity.x = 0;
-            calculateLaserEnd(walls, deltaTime);
+            calculateLaserEnd(tiles, deltaTime);
             if (mStateTimer >= mLaserChargeTime) {
                 mState = LASER_FIRE;
                 mStateTimer = 0.0f;
@@ -356,7 +343,7 @@ public:
             mStateTimer += deltaTime;
             mVelocity.x = 0;
             if (mUpdateCounter % 2 == 0) {
-                calculateLaserEnd(walls, deltaTime * 2.0f);
+                calculateLaserEnd(tiles, deltaTime * 2.0f);
             }
             if (mStateTimer > mLaserFireTime) {
                 mState = VULNERABLE;
@@ -377,7 +364,7 @@ public:
             break;
 
         case AOE_ATTACK:
-            updateAoeState(deltaTime, walls);
+            updateAoeState(deltaTime, tiles);
             break;
 
         case TELEPORT_OUT:
@@ -500,7 +487,7 @@ public:
         }
     }
 
-    void updateAoeState(float deltaTime, std::vector<Entity*>& walls) {
+    void updateAoeState(float deltaTime, const CollisionGrid& tiles) {
         mStateTimer += deltaTime;
         mVelocity.x = 0;
 
@@ -513,7 +500,7 @@ public:
         else {
             mState = TELEPORT_OUT;
             mStateTimer = 0.0f;
-            mTeleportTarget = chooseTeleportDestination(walls);
+            mTeleportTarget = chooseTeleportDestination(tiles);
             mTeleportAlpha = 1.0f;
             mAoeRadius = 0.0f;
             mCurrentFrame = mDeathFrameStart;
@@ -619,7 +606,7 @@ public:
         }
     }
 
-    void calculateLaserEnd(std::vector<Entity*>& walls, float deltaTime) {
+    void calculateLaserEnd(const CollisionGrid& tiles, float deltaTime) {
         if (!pTarget) return;
 
         mLaserStart = mCachedCenter;
@@ -643,34 +630,19 @@ public:
 
         mLaserAngle += angleDiff * trackSpeed * deltaTime;
 
-        mLaserEnd = raycastLaser(mLaserAngle, walls);
+        mLaserEnd = raycastLaser(mLaserAngle, tiles);
 
         if (mDualLaser) {
             mLaserAngle2 = mLaserAngle + PI;
-            mLaserEnd2 = raycastLaser(mLaserAngle2, walls);
+            mLaserEnd2 = raycastLaser(mLaserAngle2, tiles);
         }
     }
 
-    Vector2 raycastLaser(float angle, std::vector<Entity*>& walls) {
+    Vector2 raycastLaser(float angle, const CollisionGrid& tiles) {
         Vector2 dir = { cosf(angle), sinf(angle) };
         float maxDist = 800.0f;
-        float step = 8.0f;
-
-        for (float dist = 0; dist < maxDist; dist += step) {
-            Vector2 point = {
-                mLaserStart.x + dir.x * dist,
-                mLaserStart.y + dir.y * dist
-            };
-
-            for (auto* wall : walls) {
-                Rectangle wallRect = { wall->mPosition.x, wall->mPosition.y, wall->mSize.x, wall->mSize.y };
-                if (CheckCollisionPointRec(point, wallRect)) {
-                    return point;
-                }
-            }
-        }
 
-        return { mLaserStart.x + dir.x * maxDist, mLaserStart.y + dir.y * maxDist };
+        return Physics::RaycastTiles(mLaserStart, dir, maxDist, tiles).point;
     }
 
     bool checkAoeCollision(Entity* player) {
@@ -710,35 +682,32 @@ public:
         return { mPosition.x + 10, mPosition.y + 10, mSize.x - 20, mSize.y - 10 };
     }
 
-    void onCollision(Entity* pOther) override {
+    void onWallCollision(Rectangle otherRect) override {
         if (mState == DYING) return;
 
-        if (pOther->mType == WALL) {
-            Rectangle otherRect = { pOther->mPosition.x, pOther->mPosition.y, pOther->mSize.x, pOther->mSize.y };
-            float myCenterX = mPosition.x + mSize.x / 2.0f;
-            float myCenterY = mPosition.y + mSize.y / 2.0f;
-            float wallCenterX = otherRect.x + otherRect.width / 2.0f;
-            float wallCenterY = otherRect.y + otherRect.height / 2.0f;
+        float myCenterX = mPosition.x + mSize.x / 2.0f;
+        float myCenterY = mPosition.y + mSize.y / 2.0f;
+        float wallCenterX = otherRect.x + otherRect.width / 2.0f;
+        float wallCenterY = otherRect.y + otherRect.height / 2.0f;
 
-            float dx = fabsf(myCenterX - wallCenterX);
-            float dy = fabsf(myCenterY - wallCenterY);
+        float dx = fabsf(myCenterX - wallCenterX);
+        float dy = fabsf(myCenterY - wallCenterY);
 
-            float minDistX = (mSize.x / 2.0f) + (otherRect.width / 2.0f);
-            float minDistY = (mSize.y / 2.0f) + (otherRect.height / 2.0f);
+        float minDistX = (mSize.x / 2.0f) + (otherRect.width / 2.0f);
+        float minDistY = (mSize.y / 2.0f) + (otherRect.height / 2.0f);
 
-            float overlapX = minDistX - dx;
-            float overlapY = minDistY - dy;
+        float overlapX = minDistX - dx;
+        float overlapY = minDistY - dy;
 
-            if (overlapX < overlapY) {
-                mPosition.x += (myCenterX < wallCenterX) ? -overlapX : overlapX;
-            }
-            else {
-                mPosition.y += (myCenterY < wallCenterY) ? -overlapY : overlapY;
-            }
+        if (overlapX < overlapY) {
+            mPosition.x += (myCenterX < wallCenterX) ? -overlapX : overlapX;
+        }
+        else {
+            mPosition.y += (myCenterY < wallCenterY) ? -overlapY : overlapY;
         }
     }
 
-    void draw() override {
+    void draw(SpriteBatch& batch) override {
         if (mState == INACTIVE || !mActive) return;
 
         // Draw AOE
@@ -746,9 +715,9 @@ public:
             if (mStateTimer < mAoeWarningTime) {
                 if (mAoeRadius > 0) {
                     Color warningColor = mIsEnraged ? ORANGE : RED;
-                    DrawCircleLinesV(mCachedCenter, mAoeRadius, warningColor);
+                    batch.circleLines(SpriteDepth::BOSS_SHOTS, mCachedCenter, mAoeRadius, warningColor);
                     if ((mUpdateCounter / 3) & 1) {
-                        DrawCircleV(mCachedCenter, 10.0f, warningColor);
+                        batch.circle(SpriteDepth::BOSS_SHOTS, mCachedCenter, 10.0f, warningColor);
                     }
                 }
             }
@@ -756,8 +725,8 @@ public:
                 float progress = (mStateTimer - mAoeWarningTime) / mAoeDuration;
                 float alpha = 1.0f - progress;
                 Color explosionColor = mIsEnraged ? ORANGE : RED;
-                DrawCircleV(mCachedCenter, mAoeMaxRadius, Fade(explosionColor, alpha * 0.6f));
-                DrawCircleLinesV(mCachedCenter, mAoeMaxRadius, Fade(WHITE, alpha));
+                batch.circle(SpriteDepth::BOSS_FX, mCachedCenter, mAoeMaxRadius, Fade(explosionColor, alpha * 0.6f));
+                batch.circleLines(SpriteDepth::BOSS_FX, mCachedCenter, mAoeMaxRadius, Fade(WHITE, alpha));
             }
         }
 
@@ -771,18 +740,18 @@ public:
             Vector2 origin = { SPRITE_SIZE / 2.0f, SPRITE_SIZE / 2.0f };
 
             if (mIsEnraged) {
-                DrawCircleV(fb.position, fb.radius * 1.5f, Fade(ORANGE, 0.3f));
+                batch.circle(SpriteDepth::BOSS_SHOTS, fb.position, fb.radius * 1.5f, Fade(ORANGE, 0.3f));
             }
-            DrawTexturePro(mTexture, source, dest, origin, fb.rotation, WHITE);
+            batch.texture(SpriteDepth::BOSS_SHOTS, mTexture, source, dest, origin, fb.rotation, WHITE);
         }
 
         // Draw Laser
         if (mState == LASER_CHARGE) {
             if ((mUpdateCounter / 3) & 1) {
                 Color chargeColor = mIsEnraged ? Fade(ORANGE, 0.5f) : Fade(SKYBLUE, 0.5f);
-                DrawLineEx(mLaserStart, mLaserEnd, 2.0f, chargeColor);
+                batch.line(SpriteDepth::BOSS_FX, mLaserStart, mLaserEnd, 2.0f, chargeColor);
                 if (mDualLaser) {
-                    DrawLineEx(mLaserStart, mLaserEnd2, 2.0f, chargeColor);
+                    batch.line(SpriteDepth::BOSS_FX, mLaserStart, mLaserEnd2, 2.0f, chargeColor);
                 }
             }
         }
@@ -790,16 +759,16 @@ public:
             Color outer = mIsEnraged ? ORANGE : SKYBLUE;
             Color inner = mIsEnraged ? RED : BLUE;
 
-            DrawLineEx(mLaserStart, mLaserEnd, mLaserWidth, outer);
-            DrawLineEx(mLaserStart, mLaserEnd, mLaserWidth * 0.5f, inner);
-            DrawLineEx(mLaserStart, mLaserEnd, 2.0f, WHITE);
-            DrawCircleV(mLaserEnd, 4.0f, RAYWHITE);
+            batch.line(SpriteDepth::BOSS_FX, mLaserStart, mLaserEnd, mLaserWidth, outer);
+            batch.line(SpriteDepth::BOSS_FX, mLaserStart, mLaserEnd, mLaserWidth * 0.5f, inner);
+            batch.line(SpriteDepth::BOSS_FX, mLaserStart, mLaserEnd, 2.0f, WHITE);
+            batch.circle(SpriteDepth::BOSS_FX, mLaserEnd, 4.0f, RAYWHITE);
 
             if (mDualLaser) {
-                DrawLineEx(mLaserStart, mLaserEnd2, mLaserWidth, outer);
-                DrawLineEx(mLaserStart, mLaserEnd2, mLaserWidth * 0.5f, inner);
-                DrawLineEx(mLaserStart, mLaserEnd2, 2.0f, WHITE);
-                DrawCircleV(mLaserEnd2, 4.0f, RAYWHITE);
+                batch.line(SpriteDepth::BOSS_FX, mLaserStart, mLaserEnd2, mLaserWidth, outer);
+                batch.line(SpriteDepth::BOSS_FX, mLaserStart, mLaserEnd2, mLaserWidth * 0.5f, inner);
+                batch.line(SpriteDepth::BOSS_FX, mLaserStart, mLaserEnd2, 2.0f, WHITE);
+                batch.circle(SpriteDepth::BOSS_FX, mLaserEnd2, 4.0f, RAYWHITE);
             }
         }
 
@@ -830,10 +799,10 @@ public:
 
         if (mIsEnraged && mState != TELEPORT_OUT && mState != TELEPORT_IN) {
             if ((mUpdateCounter / 4) & 1) {
-                DrawCircleV(mCachedCenter, mSize.x * 0.7f, Fade(ORANGE, 0.2f));
+                batch.circle(SpriteDepth::BOSS, mCachedCenter, mSize.x * 0.7f, Fade(ORANGE, 0.2f));
             }
         }
 
-        DrawTextureRec(mTexture, source, drawPos, bossColor);
+        batch.texture(SpriteDepth::BOSS, mTexture, source, drawPos, bossColor);
     }
 };
\ No newline at end of file
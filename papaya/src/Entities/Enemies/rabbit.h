@@ -6,7 +6,6 @@
 class RabbitEnemy : public Entity {
 public:
     Vector2 mVelocity = { 0, 0 };
-    Vector2 mPrevPosition = { 0, 0 };
 
     enum RabbitState {
         RABBIT_IDLE,
@@ -357,11 +356,8 @@ public:
         }
     }
 
-    void onCollision(Entity* pOther) override {
-        if (pOther->mType != WALL) return;
-
+    void onWallCollision(Rectangle wallRect) override {
         Rectangle myRect = getRect();
-        Rectangle wallRect = pOther->getRect();
 
         float overlapLeft = (myRect.x + myRect.width) - wallRect.x;
         float overlapRight = (wallRect.x + wallRect.width) - myRect.x;
@@ -417,7 +413,7 @@ public:
         return { mPosition.x, mPosition.y, mSize.x, mSize.y };
     }
 
-    void draw() override {
+    void draw(SpriteBatch& batch) override {
         Rectangle source = {
             (float)mCurrentFrame * SPRITE_SIZE,
             0.0f,
@@ -433,6 +429,6 @@ public:
         if (mHurtTimer > 0) color = RED;
         else if (mIsDead) color = DARKGRAY;
 
-        DrawTextureRec(mTexture, source, drawPos, color);
+        batch.texture(SpriteDepth::ENEMIES, mTexture, source, drawPos, color);
     }
 };
\ No newline at end of file
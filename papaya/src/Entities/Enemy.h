@@ -47,39 +47,35 @@ public:
         return { mPosition.x, mPosition.y, mSize.x, mSize.y };
     }
 
-    void onCollision(Entity* pOther) override {
-        if (pOther->mType = WALL) {
-            Rectangle otherRect = pOther->getRect();
-
-            // Vertical collision
-            if (mPosition.y + mSize.y <= otherRect.y + 5.0f && mVelocity.y >= 0) {
-                mPosition.y = otherRect.y - mSize.y;
-                mVelocity.y = 0;
-            }
-            // Horizontal collision
-            else {
-                bool hitLeft = (mPosition.x + mSize.x > otherRect.x && mPosition.x < otherRect.x);
-                bool hitRight = (mPosition.x < otherRect.x + otherRect.width && mPosition.x + mSize.x > otherRect.x + otherRect.width);
-
-                if (hitLeft || hitRight) {
-                    if (mVelocity.x > 0) mPosition.x = otherRect.x - mSize.x;
-                    else mPosition.x = otherRect.x + otherRect.width;
-
-                    mVelocity.x *= -1;
-                    mIsFacingRight = !mIsFacingRight;
-                }
+    void onWallCollision(Rectangle otherRect) override {
+        // Vertical collision
+        if (mPosition.y + mSize.y <= otherRect.y + 5.0f && mVelocity.y >= 0) {
+            mPosition.y = otherRect.y - mSize.y;
+            mVelocity.y = 0;
+        }
+        // Horizontal collision
+        else {
+            bool hitLeft = (mPosition.x + mSize.x > otherRect.x && mPosition.x < otherRect.x);
+            bool hitRight = (mPosition.x < otherRect.x + otherRect.width && mPosition.x + mSize.x > otherRect.x + otherRect.width);
+
+            if (hitLeft || hitRight) {
+                if (mVelocity.x > 0) mPosition.x = otherRect.x - mSize.x;
+                else mPosition.x = otherRect.x + otherRect.width;
+
+                mVelocity.x *= -1;
+                mIsFacingRight = !mIsFacingRight;
             }
         }
     }
 
-    void draw() override {
+    void draw(SpriteBatch& batch) override {
         if (mIsDead) return;
 
         Color enemyColor = (mHurtTimer > 0) ? WHITE : GREEN;
 
-        DrawRectangle((int)mPosition.x, (int)mPosition.y, (int)mSize.x, (int)mSize.y, enemyColor);
+        batch.rectangle(SpriteDepth::ENEMIES, { (float)(int)mPosition.x, (float)(int)mPosition.y, (float)(int)mSize.x, (float)(int)mSize.y }, enemyColor);
 
         float eyeOffset = mIsFacingRight ? 8.0f : 2.0f;
-        DrawRectangle((int)mPosition.x + eyeOffset, (int)mPosition.y + 4, 4, 4, BLACK);
+        batch.rectangle(SpriteDepth::ENEMIES, { (float)((int)mPosition.x + (int)eyeOffset), (float)((int)mPosition.y + 4), 4, 4 }, BLACK);
     }
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "raylib.h"
+#include "Core/SpriteBatch.hpp"
 #include <vector>
 
 enum EntityType { PLAYER, WALL, MAGE_BOSS, ENEMY, RABBIT };
@@ -7,6 +8,7 @@ enum EntityType { PLAYER, WALL, MAGE_BOSS, ENEMY, RABBIT };
 class Entity {
 public:
     Vector2 mPosition;
+    Vector2 mPrevPosition;
     EntityType mType;
     Vector2 mSize;
     Texture2D mTexture = { 0 };
@@ -14,13 +16,14 @@ public:
     bool mActive = true;
     int mHealth = 1;
 
-    Entity(Vector2 pos, EntityType t) : mPosition(pos), mType(t) {}
+    Entity(Vector2 pos, EntityType t) : mPosition(pos), mPrevPosition(pos), mType(t) {}
 
     virtual ~Entity() {}
 
     virtual void update(float deltaTime) = 0;
-    virtual void draw() = 0;
+    virtual void draw(SpriteBatch& batch) = 0;
     virtual Rectangle getRect() = 0;
 
-    virtual void onCollision(Entity* other) = 0;
+    virtual void onCollision(Entity*) {}
+    virtual void onWallCollision(Rectangle) {}
 };
\ No newline at end of file
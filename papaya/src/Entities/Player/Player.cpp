@@ -2,6 +2,8 @@
 #include "Core/InputHelper.h"
 #include "Core/MathUtils.h"
 #include "Audio/AudioManager.hpp"
+#include "Core/AssetCache.hpp"
+#include "Core/GameConstants.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -16,15 +18,18 @@ Player::Player(float startX, float startY)
     mPrevPosition = mPosition;
     mSize = { HITBOX_WIDTH, HITBOX_HEIGHT };
 
-    mSlashTexture = LoadTexture("assets/slash.png");
-    mWingsTexture = LoadTexture("assets/jump_wings.png");
+    mSlashTexture = AssetCache::shared().acquireTexture(GameConstants::SLASH_TEXTURE_PATH);
+    mWingsTexture = AssetCache::shared().acquireTexture(GameConstants::WINGS_TEXTURE_PATH);
+
+    mJumpSound = AudioManager::getInstance()->findSound("jump");
+    mAttackSound = AudioManager::getInstance()->findSound("attack");
 
     mCurrentAnim = AnimationData::GetAnimationData(AnimState::IDLE);
 }
 
 Player::~Player() {
-    UnloadTexture(mSlashTexture);
-    UnloadTexture(mWingsTexture);
+    AssetCache::shared().releaseTexture(GameConstants::SLASH_TEXTURE_PATH);
+    AssetCache::shared().releaseTexture(GameConstants::WINGS_TEXTURE_PATH);
 }
 
 void Player::update(float deltaTime) {
@@ -57,18 +62,16 @@ Rectangle Player::getRect() {
     return { mPosition.x, mPosition.y, mSize.x, mSize.y };
 }
 
-void Player::onCollision(Entity* other) {
-    if (other->mType == WALL) {
-        handleWallCollision(other->getRect());
-    }
+void Player::onWallCollision(Rectangle wallRect) {
+    handleWallCollision(wallRect);
 }
 
-void Player::draw() {
-    drawGhosts();
-    drawWings();
-    drawSlash();
-    drawPlayer();
-    drawUI();
+void Player::draw(SpriteBatch& batch) {
+    drawGhosts(batch);
+    drawWings(batch);
+    drawSlash(batch);
+    drawPlayer(batch);
+    drawUI(batch);
 }
 
 bool Player::hasHit(Entity* enemy) const {
@@ -273,7 +276,7 @@ void Player::handleJump(float dt) {
     }
 
     if (jumped) {
-        AudioManager::getInstance()->playSoundRandomPitch("jump");
+        AudioManager::getInstance()->playSoundRandomPitchAt(mJumpSound, mPosition);
         mCoyoteTimeCounter = 0;
         mJumpBufferCounter = 0;
         mIsGrounded = false;
@@ -462,7 +465,7 @@ void Player::handleAttack(float dt) {
 
     WeaponStats stats = getCurrentWeaponStats();
 
-    AudioManager::getInstance()->playSoundRandomPitch("attack");
+    AudioManager::getInstance()->playSoundRandomPitchAt(mAttackSound, mPosition);
 
     mIsAttacking = true;
     mCurrentState = AnimState::ATTACK;
@@ -643,7 +646,7 @@ void Player::handleGhosts(float dt) {
     }
 }
 
-void Player::drawGhosts() {
+void Player::drawGhosts(SpriteBatch& batch) {
     for (const auto& ghost : mGhosts) {
         float width = ghost.facingRight ? ghost.frameRec.width : -ghost.frameRec.width;
         Rectangle src = { ghost.frameRec.x, ghost.frameRec.y, width, ghost.frameRec.height };
@@ -652,11 +655,11 @@ void Player::drawGhosts() {
 
         Rectangle dest = { pos.x, pos.y, FRAME_WIDTH, FRAME_HEIGHT };
 
-        DrawTexturePro(mTexture, src, dest, { 0, 0 }, 0.0f, Fade(SKYBLUE, ghost.alpha));
+        batch.texture(SpriteDepth::PLAYER_TRAIL, mTexture, src, dest, { 0, 0 }, 0.0f, Fade(SKYBLUE, ghost.alpha));
     }
 }
 
-void Player::drawWings() {
+void Player::drawWings(SpriteBatch& batch) {
     if (!mWingsActive) return;
 
     constexpr float WING_W = 32.0f;
@@ -679,10 +682,10 @@ void Player::drawWings() {
         center.y - WING_H / 2.0f + 1.0f
     };
 
-    DrawTextureRec(mWingsTexture, src, pos, Fade(WHITE, 0.5f));
+    batch.texture(SpriteDepth::PLAYER_FX, mWingsTexture, src, pos, Fade(WHITE, 0.5f));
 }
 
-void Player::drawSlash() {
+void Player::drawSlash(SpriteBatch& batch) {
     if (!mIsAttacking) return;
 
     WeaponStats stats = getCurrentWeaponStats();
@@ -758,7 +761,7 @@ void Player::drawSlash() {
         };
     }
 
-    DrawTexturePro(mSlashTexture, src, dest, origin, rotation, color);
+    batch.texture(SpriteDepth::PLAYER_FX, mSlashTexture, src, dest, origin, rotation, color);
 
     if (mComboCount == 2) {
         Rectangle ghostDest = {
@@ -769,19 +772,19 @@ void Player::drawSlash() {
             ghostDest.width / 2.0f,
             ghostDest.height / 2.0f
         };
-        DrawTexturePro(mSlashTexture, src, ghostDest, ghostOrigin,
+        batch.texture(SpriteDepth::PLAYER_FX, mSlashTexture, src, ghostDest, ghostOrigin,
             rotation - 10.0f * stats.rotationSpeed,
             Fade(GOLD, 0.5f));
     }
 
     if (stats.attackCooldown < 0.1f && frame >= 1) {
-        DrawTexturePro(mSlashTexture, src, dest, origin,
+        batch.texture(SpriteDepth::PLAYER_FX, mSlashTexture, src, dest, origin,
             rotation + 8.0f,
             Fade(color, 0.3f));
     }
 }
 
-void Player::drawPlayer() {
+void Player::drawPlayer(SpriteBatch& batch) {
     float offsetX = (FRAME_WIDTH - HITBOX_WIDTH) / 2.0f;
     float offsetY = (FRAME_HEIGHT - HITBOX_HEIGHT) / 2.0f;
 
@@ -809,10 +812,10 @@ void Player::drawPlayer() {
     if (mInvincibilityTimer > 0.0f && (int)(mInvincibilityTimer * 20.0f) % 2 == 0)
         color = RED;
 
-    DrawTexturePro(mTexture, src, dest, { 0, 0 }, 0.0f, color);
+    batch.texture(SpriteDepth::PLAYER, mTexture, src, dest, { 0, 0 }, 0.0f, color);
 }
 
-void Player::drawUI() {
+void Player::drawUI(SpriteBatch& batch) {
     if (mStamina < MAX_STAMINA) {
         constexpr float BAR_W = 20.0f;
         constexpr float BAR_H = 2.0f;
@@ -821,15 +824,13 @@ void Player::drawUI() {
         float percent = mStamina / MAX_STAMINA;
 
         if (percent < 0.5f) {
-            DrawRectangle((int)barX, (int)barY,
-                (int)(BAR_W * percent), (int)BAR_H,
+            batch.rectangle(SpriteDepth::OVERLAY, { (float)(int)barX, (float)(int)barY, (float)(int)(BAR_W * percent), (float)(int)BAR_H },
                 ColorAlpha(RED, percent));
         }
     }
 
     if (mIsAttacking || mComboWindowOpen) {
         float progress = mComboWindowTimer / COMBO_WINDOW;
-        DrawRectangle((int)mPosition.x - 3, (int)mPosition.y - 12,
-            (int)(16.0f * progress), 2, YELLOW);
+        batch.rectangle(SpriteDepth::OVERLAY, { (float)((int)mPosition.x - 3), (float)((int)mPosition.y - 12), (float)(int)(16.0f * progress), 2 }, YELLOW);
     }
 }
\ No newline at end of file
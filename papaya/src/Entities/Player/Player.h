@@ -2,6 +2,7 @@
 #include "raylib.h"
 #include <vector>
 #include "Entities/Entity.h"
+#include "Audio/AudioManager.hpp"
 #include "PlayerConstants.h" 
 #include "PlayerTypes.h"
 
@@ -11,9 +12,9 @@ public:
     ~Player();
 
     void update(float deltaTime) override;
-    void draw() override;
+    void draw(SpriteBatch& batch) override;
     Rectangle getRect() override;
-    void onCollision(Entity* other) override;
+    void onWallCollision(Rectangle wallRect) override;
 
     void lateUpdate(float deltaTime);
     bool hasHit(Entity* enemy) const;
@@ -33,7 +34,6 @@ public:
     bool mNoclip = false;
 
     Vector2 mVelocity = { 0, 0 };
-    Vector2 mPrevPosition = { 0, 0 };
     bool mIsAttacking = false;
     Rectangle mAttackArea = { 0, 0, 0, 0 };
     std::vector<Entity*> mHitEntities;
@@ -90,6 +90,9 @@ private:
     Texture2D mSlashTexture;
     Texture2D mWingsTexture;
 
+    SoundHandle mJumpSound = INVALID_SOUND;
+    SoundHandle mAttackSound = INVALID_SOUND;
+
     std::vector<Ghost> mGhosts;
     float mGhostSpawnTimer = 0.0f;
     bool mWingsActive = false;
@@ -118,9 +121,9 @@ private:
     void handleGhosts(float dt);
     void determineAnimationState();
 
-    void drawGhosts();
-    void drawWings();
-    void drawSlash();
-    void drawPlayer();
-    void drawUI();
+    void drawGhosts(SpriteBatch& batch);
+    void drawWings(SpriteBatch& batch);
+    void drawSlash(SpriteBatch& batch);
+    void drawPlayer(SpriteBatch& batch);
+    void drawUI(SpriteBatch& batch);
 };
\ No newline at end of file
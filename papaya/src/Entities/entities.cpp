@@ -6,7 +6,6 @@
 #include "../Entities/Enemy.h"
 #include "../Entities/Entity.h"
 #include "../Entities/Player/Player.h"
-#include "../external_headers/json.hpp"
 #include "../Entities/Enemies/mage_boss.h"
 #include "../Entities/Enemies/rabbit.h"
 
@@ -62,6 +61,18 @@ void EntitySaver::addEntityS(EntityS entity) {
     if (!(*fileStream)) throw std::runtime_error("Failed to write entity to stream");
 }
 
+void EntitySaver::addEntitiesS(const std::vector<EntityS>& entities) {
+    if (entities.empty()) return;
+
+    std::vector<uint64_t> data;
+    data.reserve(entities.size());
+    for (const auto& entity : entities) data.push_back(createEntityS(entity));
+
+    fileStream->write(reinterpret_cast<const char*>(data.data()),
+        static_cast<std::streamsize>(data.size() * sizeof(uint64_t)));
+    if (!(*fileStream)) throw std::runtime_error("Failed to write entities to stream");
+}
+
 void EntitySaver::addEntity(const std::unique_ptr<Entity>& entity) {
     EntityS entityS;
     // Convert Pixel pos to Tile pos
@@ -73,58 +84,6 @@ void EntitySaver::addEntity(const std::unique_ptr<Entity>& entity) {
     addEntityS(entityS);
 }
 
-void EntitySaver::fromEditor(std::string json) {
-    using jsonn = nlohmann::json;
-    auto doc = jsonn::parse(json);
-
-    if (!doc.contains("chunkData")) return;
-
-    auto arr = doc["chunkData"]["entities"];
-    int chunkX = doc["chunkData"]["x"].get<int>();
-    int chunkY = doc["chunkData"]["y"].get<int>();
-
-    if (arr.is_null() || !arr.is_array() || arr.size() == 0) return;
-
-    std::cout << "[SYSTEM] Przetwarzanie chunka (" << chunkX << "," << chunkY << ")..." << std::endl;
-
-    for (long unsigned int i = 0; i < arr.size(); ++i) {
-        for (long unsigned int j = 0; j < arr[i].size(); ++j) {
-
-            uint8_t editorID = arr[i][j];
-            if (editorID == 0) continue;
-
-            EntityType gameType;
-
-            // Map Editor ID -> Game Enum
-            switch (editorID) {
-            case 1:
-                gameType = RABBIT;
-                std::cout << " -> Mapowanie: EditorID 1 -> RABBIT" << std::endl;
-                break;
-            case 2:
-                gameType = MAGE_BOSS;
-                std::cout << " -> Mapowanie: EditorID 2 -> MAGE_BOSS" << std::endl;
-                break;
-            default:
-                std::cout << " -> WARNING: Nieznane ID (" << (int)editorID << "), ustawiam RABBIT" << std::endl;
-                gameType = RABBIT;
-                break;
-            }
-
-            int globalTileX = static_cast<int>(j) + (chunkX * 64);
-            int globalTileY = static_cast<int>(i) + (chunkY * 64);
-
-            EntityS entity;
-            entity.x = static_cast<int16_t>(globalTileX);
-            entity.y = static_cast<int16_t>(globalTileY);
-            entity.entityType = gameType;
-            entity.health = 10;
-
-            this->addEntityS(entity);
-        }
-    }
-}
-
 EntitySaver::~EntitySaver() {}
 
 EntityLoader::EntityLoader(std::fstream& f) : fileStream(&f) {}
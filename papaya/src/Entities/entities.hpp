@@ -28,10 +28,9 @@ private:
 public:
     explicit EntitySaver(std::fstream& f);
     void addEntityS(EntityS entity);
+    void addEntitiesS(const std::vector<EntityS>& entities);
     int mTextureID = 0;
     void addEntity(const std::unique_ptr<Entity>& entity);
-
-    void fromEditor(std::string json);
     ~EntitySaver();
 };
 
@@ -0,0 +1,9 @@
+#pragma once
+
+// Keyboard state fed to the stubbed raylib input functions in headless builds.
+namespace Headless {
+    void setKeyDown(int key, bool down);
+    // Reports `key` as pressed (and held) until the next clearPressedKeys().
+    void pressKey(int key);
+    void clearPressedKeys();
+}
@@ -0,0 +1,118 @@
+#include "Core/GameWrapper.hpp"
+#include "Core/AssetCache.hpp"
+#include "Core/GameConstants.hpp"
+#include "Core/Profiler.hpp"
+#include "Headless/headless_input.hpp"
+#include "raylib.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Symulacja bez okna i GPU: N klatek z podanego slotu, rysowanie i dźwięk to puste funkcje.
+// Użycie: papaya_headless [slot] [klatki] [fps] [plik_trace.json]
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    double elapsedMs(Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+    // Stały skrypt sterowania, żeby gracz faktycznie biegał, skakał i atakował
+    void scriptInput(int frame, int fps) {
+        Headless::clearPressedKeys();
+
+        bool goRight = (frame / (fps * 2)) % 2 == 0;
+        Headless::setKeyDown(KEY_RIGHT, goRight);
+        Headless::setKeyDown(KEY_LEFT, !goRight);
+
+        if (frame % std::max(1, fps / 2) == 0) Headless::pressKey(KEY_SPACE);
+        if (frame % std::max(1, fps / 3) == 1) Headless::pressKey(KEY_Z);
+        if (frame % (fps * 3) == 2) Headless::pressKey(KEY_C);
+    }
+
+    double percentile(const std::vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0.0;
+        size_t idx = (size_t)(p * (sorted.size() - 1));
+        return sorted[idx];
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string slot = (argc > 1) ? argv[1] : GameConstants::currentSavePath;
+    int frames = (argc > 2) ? std::stoi(argv[2]) : 3600;
+    int fps = (argc > 3) ? std::stoi(argv[3]) : 60;
+    if (frames <= 0 || fps <= 0) {
+        std::cout << "Użycie: papaya_headless [slot] [klatki] [fps] [plik_trace.json]" << std::endl;
+        return 1;
+    }
+
+    // Praca na kopii slotu - zapis przy zamykaniu nie może nadpisać oryginału
+    fs::path workDir = fs::temp_directory_path() / "papaya_headless";
+    std::error_code ec;
+    fs::remove_all(workDir, ec);
+    fs::create_directories(workDir);
+    if (fs::exists(slot)) {
+        fs::copy(slot, workDir, fs::copy_options::recursive | fs::copy_options::overwrite_existing);
+    }
+    GameConstants::currentSavePath = workDir.string();
+
+    std::cout << "[HEADLESS] Slot: " << slot << ", klatki: " << frames << ", fps: " << fps << std::endl;
+
+    std::vector<double> frameMs;
+    frameMs.reserve(frames);
+    double loadMs = 0.0;
+
+    {
+        bool shouldQuit = false;
+        int state = 1;
+        float dt = 1.0f / fps;
+
+        Clock::time_point loadStart = Clock::now();
+        GameWrapper game(shouldQuit, state);
+        game.finishLoading();
+        loadMs = elapsedMs(loadStart, Clock::now());
+
+        for (int i = 0; i < frames && !shouldQuit; i++) {
+            scriptInput(i, fps);
+
+            Clock::time_point start = Clock::now();
+            game.updateFrame(dt);
+            frameMs.push_back(elapsedMs(start, Clock::now()));
+        }
+    }
+    AssetCache::shared().clear();
+    AudioManager::getInstance()->shutdown();
+
+    fs::remove_all(workDir, ec);
+
+    double totalMs = 0.0;
+    for (double ms : frameMs) totalMs += ms;
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+
+    double simSeconds = (double)frameMs.size() / fps;
+    double simSteps = simSeconds / GameConstants::SIM_DT;
+
+    std::cout << "[HEADLESS] Ładowanie: " << loadMs << " ms" << std::endl;
+    std::cout << "[HEADLESS] Klatki: " << frameMs.size() << " (" << simSeconds << " s gry, ~" << std::llround(simSteps) << " kroków)" << std::endl;
+    std::cout << "[HEADLESS] Razem: " << totalMs << " ms, średnio: " << (frameMs.empty() ? 0.0 : totalMs / frameMs.size()) << " ms/klatkę" << std::endl;
+    std::cout << "[HEADLESS] p50: " << percentile(sorted, 0.50) << " ms, p95: " << percentile(sorted, 0.95)
+        << " ms, p99: " << percentile(sorted, 0.99) << " ms, max: " << (sorted.empty() ? 0.0 : sorted.back()) << " ms" << std::endl;
+    if (totalMs > 0.0) {
+        std::cout << "[HEADLESS] Krok symulacji: " << (totalMs * 1000.0 / simSteps) << " us" << std::endl;
+    }
+
+    if (argc > 4) {
+        size_t count = Profiler::get().dumpChromeTrace(argv[4]);
+        std::cout << "[HEADLESS] Trace: " << count << " zdarzeń -> " << argv[4] << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,206 @@
+#include "raylib.h"
+#include "Headless/headless_input.hpp"
+
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+// Implementacje funkcji raylib dla papaya_headless: rysowanie, tekstury i dźwięk nic nie robią,
+// kolizje, losowanie i wejście działają naprawdę, żeby symulacja zachowywała się jak w grze.
+
+namespace {
+    constexpr int KEY_COUNT = 512;
+    bool gKeyDown[KEY_COUNT] = {};
+    bool gKeyPressed[KEY_COUNT] = {};
+
+    // Stałe ziarno - kolejne przebiegi benchmarku są powtarzalne
+    std::mt19937 gRandom(12345u);
+
+    bool validKey(int key) { return key >= 0 && key < KEY_COUNT; }
+}
+
+namespace Headless {
+    void setKeyDown(int key, bool down) {
+        if (validKey(key)) gKeyDown[key] = down;
+    }
+
+    void pressKey(int key) {
+        if (!validKey(key)) return;
+        gKeyDown[key] = true;
+        gKeyPressed[key] = true;
+    }
+
+    void clearPressedKeys() {
+        std::memset(gKeyPressed, 0, sizeof(gKeyPressed));
+    }
+}
+
+// =============================================================================
+// WEJŚCIE, CZAS, LOSOWANIE
+// =============================================================================
+
+bool IsKeyDown(int key) { return validKey(key) && gKeyDown[key]; }
+bool IsKeyPressed(int key) { return validKey(key) && gKeyPressed[key]; }
+
+float GetFrameTime(void) { return 1.0f / 60.0f; }
+int GetFPS(void) { return 0; }
+
+int GetRandomValue(int min, int max) {
+    if (min > max) std::swap(min, max);
+    return std::uniform_int_distribution<int>(min, max)(gRandom);
+}
+
+bool FileExists(const char* fileName) {
+    std::error_code ec;
+    return std::filesystem::is_regular_file(fileName, ec);
+}
+
+const char* TextFormat(const char* text, ...) {
+    static char buffer[1024];
+    va_list args;
+    va_start(args, text);
+    vsnprintf(buffer, sizeof(buffer), text, args);
+    va_end(args);
+    return buffer;
+}
+
+int MeasureText(const char* text, int fontSize) {
+    return text ? (int)std::strlen(text) * fontSize / 2 : 0;
+}
+
+Color Fade(Color color, float alpha) {
+    alpha = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+    color.a = (unsigned char)(255.0f * alpha);
+    return color;
+}
+
+Color ColorAlpha(Color color, float alpha) {
+    return Fade(color, alpha);
+}
+
+// =============================================================================
+// KOLIZJE
+// =============================================================================
+
+bool CheckCollisionRecs(Rectangle rec1, Rectangle rec2) {
+    return (rec1.x < rec2.x + rec2.width) && (rec1.x + rec1.width > rec2.x) &&
+        (rec1.y < rec2.y + rec2.height) && (rec1.y + rec1.height > rec2.y);
+}
+
+bool CheckCollisionCircleRec(Vector2 center, float radius, Rectangle rec) {
+    float recCenterX = rec.x + rec.width / 2.0f;
+    float recCenterY = rec.y + rec.height / 2.0f;
+
+    float dx = std::fabs(center.x - recCenterX);
+    float dy = std::fabs(center.y - recCenterY);
+
+    if (dx > (rec.width / 2.0f + radius)) return false;
+    if (dy > (rec.height / 2.0f + radius)) return false;
+    if (dx <= (rec.width / 2.0f)) return true;
+    if (dy <= (rec.height / 2.0f)) return true;
+
+    float cornerX = dx - rec.width / 2.0f;
+    float cornerY = dy - rec.height / 2.0f;
+    return (cornerX * cornerX + cornerY * cornerY) <= (radius * radius);
+}
+
+bool CheckCollisionCircleLine(Vector2 center, float radius, Vector2 p1, Vector2 p2) {
+    float dx = p1.x - p2.x;
+    float dy = p1.y - p2.y;
+
+    if ((std::fabs(dx) + std::fabs(dy)) <= 1e-6f) {
+        float cx = center.x - p1.x, cy = center.y - p1.y;
+        return cx * cx + cy * cy <= radius * radius;
+    }
+
+    float lengthSq = dx * dx + dy * dy;
+    float dot = (((center.x - p1.x) * (p2.x - p1.x)) + ((center.y - p1.y) * (p2.y - p1.y))) / lengthSq;
+    if (dot > 1.0f) dot = 1.0f;
+    else if (dot < 0.0f) dot = 0.0f;
+
+    float px = p1.x + dot * (p2.x - p1.x) - center.x;
+    float py = p1.y + dot * (p2.y - p1.y) - center.y;
+    return px * px + py * py <= radius * radius;
+}
+
+// =============================================================================
+// GRAFIKA (puste)
+// =============================================================================
+
+void BeginDrawing(void) {}
+void EndDrawing(void) {}
+void ClearBackground(Color) {}
+void BeginMode2D(Camera2D) {}
+void EndMode2D(void) {}
+void BeginTextureMode(RenderTexture2D) {}
+void EndTextureMode(void) {}
+void BeginShaderMode(Shader) {}
+void EndShaderMode(void) {}
+
+// Shader o id 0 jest nieważny, więc gra zostaje przy wypieczonych chunkach
+Shader LoadShader(const char*, const char*) { return Shader{}; }
+bool IsShaderValid(Shader shader) { return shader.id > 0; }
+int GetShaderLocation(Shader, const char*) { return -1; }
+void SetShaderValue(Shader, int, const void*, int) {}
+void SetShaderValueTexture(Shader, int, Texture2D) {}
+void UnloadShader(Shader) {}
+
+// Niezerowe id, żeby AssetCache uznał teksturę za wczytaną
+Texture2D LoadTexture(const char*) { return Texture2D{ 1, 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 }; }
+Texture2D LoadTextureFromImage(Image) { return Texture2D{ 1, 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 }; }
+Image LoadImage(const char*) { return Image{}; }
+void UnloadImage(Image) {}
+void UnloadTexture(Texture2D) {}
+void UpdateTexture(Texture2D, const void*) {}
+void SetTextureFilter(Texture2D, int) {}
+void SetTextureWrap(Texture2D, int) {}
+RenderTexture2D LoadRenderTexture(int, int) { return RenderTexture2D{}; }
+void UnloadRenderTexture(RenderTexture2D) {}
+
+void DrawText(const char*, int, int, int, Color) {}
+void DrawRectangle(int, int, int, int, Color) {}
+void DrawRectangleRec(Rectangle, Color) {}
+void DrawRectangleLines(int, int, int, int, Color) {}
+void DrawRectangleLinesEx(Rectangle, float, Color) {}
+void DrawRectangleGradientV(int, int, int, int, Color, Color) {}
+void DrawCircleV(Vector2, float, Color) {}
+void DrawCircleLines(int, int, float, Color) {}
+void DrawCircleLinesV(Vector2, float, Color) {}
+void DrawLineEx(Vector2, Vector2, float, Color) {}
+void DrawTextureRec(Texture2D, Rectangle, Vector2, Color) {}
+void DrawTexturePro(Texture2D, Rectangle, Rectangle, Vector2, float, Color) {}
+
+// =============================================================================
+// AUDIO (puste)
+// =============================================================================
+
+void InitAudioDevice(void) {}
+void CloseAudioDevice(void) {}
+bool IsAudioDeviceReady(void) { return true; }
+
+Sound LoadSound(const char*) { return Sound{}; }
+Wave LoadWave(const char*) { return Wave{}; }
+Sound LoadSoundFromWave(Wave) { return Sound{}; }
+void UnloadWave(Wave) {}
+void UnloadSound(Sound) {}
+Sound LoadSoundAlias(Sound source) { return source; }
+void UnloadSoundAlias(Sound) {}
+void PlaySound(Sound) {}
+void StopSound(Sound) {}
+bool IsSoundPlaying(Sound) { return false; }
+void SetSoundVolume(Sound, float) {}
+void SetSoundPitch(Sound, float) {}
+void SetSoundPan(Sound, float) {}
+
+Music LoadMusicStream(const char*) { return Music{}; }
+void UnloadMusicStream(Music) {}
+void PlayMusicStream(Music) {}
+void StopMusicStream(Music) {}
+void UpdateMusicStream(Music) {}
+void SetMusicVolume(Music, float) {}
+bool IsMusicStreamPlaying(Music) { return false; }
+float GetMusicTimeLength(Music) { return 0.0f; }
+float GetMusicTimePlayed(Music) { return 0.0f; }
@@ -1,48 +1,197 @@
 #include "map.hpp"
+#include "mapped_file.hpp"
+#include "../Core/Profiler.hpp"
 #include <algorithm>
+#include <cstring>
 #include <iostream>
-#include <nlohmann/json.hpp>
+#include <map>
 
 namespace {
-    struct EditorBlock {
-        int textureID = 0;
-        bool collision = false;
-        bool damage = false;
-        int layer = 0;
+    bool sortByX(uint64_t a, uint64_t b) {
+        Block blockA = decodeBlock(a);
+        Block blockB = decodeBlock(b);
+        if (blockA.x != blockB.x) return blockA.x < blockB.x;
+        return blockA.y < blockB.y;
+    }
+
+    bool chunkBefore(int ax, int ay, int bx, int by) {
+        if (ay != by) return ay < by;
+        return ax < bx;
+    }
+
+    void decodeInto(uint64_t blockData, MapData& out) {
+        Block block = decodeBlock(blockData);
+
+        if (block.extraData == ExtraData::COLLIDABLE) {
+            out.collisions.emplace_back(
+                block.x * TILE_SIZE,
+                block.y * TILE_SIZE,
+                block.x_length * TILE_SIZE,
+                block.y_length * TILE_SIZE
+            );
+        }
+        else if (block.extraData == ExtraData::DAMAGING) {
+            out.damagingZones.emplace_back(
+                block.x * TILE_SIZE,
+                block.y * TILE_SIZE,
+                block.x_length * TILE_SIZE,
+                block.y_length * TILE_SIZE
+            );
+        }
+
+        if (block.textureID > 0) {
+            out.renderTiles.push_back({
+                block.x * TILE_SIZE,
+                block.y * TILE_SIZE,
+                block.textureID,
+                block.layer
+                });
+        }
+    }
+
+    uint64_t readRecord(const uint8_t* bytes, size_t index) {
+        uint64_t blockData;
+        std::memcpy(&blockData, bytes + index * sizeof(uint64_t), sizeof(blockData));
+        return blockData;
+    }
+
+    void decodeRange(const uint8_t* bytes, size_t blockCount, MapData& out) {
+        out.blockCount += blockCount;
+        out.renderTiles.reserve(out.renderTiles.size() + blockCount);
+
+        for (size_t i = 0; i < blockCount; ++i) {
+            decodeInto(readRecord(bytes, i), out);
+        }
+    }
+
+    // Whole file contents, memory mapped when possible
+    class FileBytes {
+    private:
+        MappedFile mMapped;
+        std::vector<uint8_t> mBuffer;
+
+    public:
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+
+        FileBytes(const std::filesystem::path& path, std::fstream& fallback) : mMapped(path) {
+            if (mMapped.isOpen()) {
+                data = mMapped.data();
+                size = mMapped.size();
+                return;
+            }
+
+            // Fallback when the file cannot be mapped: one bulk read instead of a read per block
+            fallback.clear();
+            fallback.seekg(0, std::ios::end);
+            std::streamsize fileSize = fallback.tellg();
+            fallback.seekg(0, std::ios::beg);
+
+            if (fileSize > 0) {
+                mBuffer.resize(static_cast<size_t>(fileSize));
+                fallback.read(reinterpret_cast<char*>(mBuffer.data()), fileSize);
+                mBuffer.resize(static_cast<size_t>(fallback.gcount()));
+            }
+            fallback.clear();
+
+            data = mBuffer.data();
+            size = mBuffer.size();
+        }
     };
 
-    Block editorBlockToBlock(const EditorBlock& eBlock, uint16_t x, uint16_t y) {
-        Block block;
-        block.x = static_cast<int16_t>(x);
-        block.y = static_cast<int16_t>(y);
-        block.x_length = 1;
-        block.y_length = 1;
-        block.textureID = static_cast<uint16_t>(eBlock.textureID);
-        block.layer = static_cast<Layers>(eBlock.layer);
+    struct RegionView {
+        bool legacy = false;
+        std::vector<RegionChunkEntry> directory;
+        const uint8_t* blocks = nullptr;
+        size_t blockCount = 0;
+    };
 
-        if (eBlock.collision) {
-            block.extraData = ExtraData::COLLIDABLE;
+    bool parseRegion(const uint8_t* bytes, size_t size, RegionView& view) {
+        RegionHeader header;
+        if (size < sizeof(header) || std::memcmp(bytes, REGION_MAGIC, sizeof(REGION_MAGIC)) != 0) {
+            view.legacy = true;
+            view.blocks = bytes;
+            view.blockCount = size / sizeof(uint64_t);
+            return true;
         }
-        else if (eBlock.damage) {
-            block.extraData = ExtraData::DAMAGING;
+
+        std::memcpy(&header, bytes, sizeof(header));
+        if (header.version != REGION_VERSION) {
+            std::cerr << "[ERROR] Nieobsługiwana wersja map.bin: " << header.version << std::endl;
+            return false;
         }
-        else {
-            block.extraData = ExtraData::NONE;
+
+        size_t dataStart = sizeof(header) + static_cast<size_t>(header.chunkCount) * sizeof(RegionChunkEntry);
+        if (dataStart > size) {
+            std::cerr << "[ERROR] Uszkodzony katalog chunków w map.bin" << std::endl;
+            return false;
         }
 
-        return block;
+        view.directory.resize(header.chunkCount);
+        std::memcpy(view.directory.data(), bytes + sizeof(header), header.chunkCount * sizeof(RegionChunkEntry));
+        view.blocks = bytes + dataStart;
+        view.blockCount = (size - dataStart) / sizeof(uint64_t);
+
+        for (const auto& entry : view.directory) {
+            if (entry.firstBlock > view.blockCount || entry.blockCount > view.blockCount - entry.firstBlock) {
+                std::cerr << "[ERROR] Chunk (" << entry.chunkX << "," << entry.chunkY << ") poza plikiem map.bin" << std::endl;
+                return false;
+            }
+        }
+        return true;
     }
 
-    bool sortByX(uint64_t a, uint64_t b) {
-        uint16_t ax = static_cast<uint16_t>((a >> 48) & 0xFFFF);
-        uint16_t bx = static_cast<uint16_t>((b >> 48) & 0xFFFF);
-        return ax < bx;
+    std::vector<RegionChunk> readRegionFile(const std::filesystem::path& path, std::fstream& stream) {
+        stream.flush();
+        FileBytes file(path, stream);
+        RegionView view;
+        std::vector<RegionChunk> chunks;
+        if (!parseRegion(file.data, file.size, view)) return chunks;
+
+        if (!view.legacy) {
+            chunks.reserve(view.directory.size());
+            for (const auto& entry : view.directory) {
+                RegionChunk chunk;
+                chunk.chunkX = entry.chunkX;
+                chunk.chunkY = entry.chunkY;
+                chunk.blocks.resize(static_cast<size_t>(entry.blockCount));
+                if (!chunk.blocks.empty()) {
+                    std::memcpy(chunk.blocks.data(), view.blocks + entry.firstBlock * sizeof(uint64_t),
+                        chunk.blocks.size() * sizeof(uint64_t));
+                }
+                chunks.push_back(std::move(chunk));
+            }
+            return chunks;
+        }
+
+        std::map<std::pair<int, int>, std::vector<uint64_t>> grouped;
+        for (size_t i = 0; i < view.blockCount; ++i) {
+            uint64_t blockData = readRecord(view.blocks, i);
+            grouped[{ blockChunkY(blockData), blockChunkX(blockData) }].push_back(blockData);
+        }
+
+        for (auto& [key, blocks] : grouped) {
+            chunks.push_back({ key.second, key.first, std::move(blocks) });
+        }
+        return chunks;
     }
 }
 
+int tileToChunk(int tile) {
+    return tile >= 0 ? tile / CHUNK_SIZE : (tile + 1) / CHUNK_SIZE - 1;
+}
+
+int blockChunkX(uint64_t blockData) {
+    return tileToChunk(static_cast<int16_t>((blockData >> 48) & 0xFFFF));
+}
+
+int blockChunkY(uint64_t blockData) {
+    return tileToChunk(static_cast<int16_t>((blockData >> 32) & 0xFFFF));
+}
+
 uint64_t createBlock(Block block) {
-    if (block.x_length > 63) block.x_length = 63;
-    if (block.y_length > 63) block.y_length = 63;
+    if (block.x_length > MAX_BLOCK_LENGTH) block.x_length = MAX_BLOCK_LENGTH;
+    if (block.y_length > MAX_BLOCK_LENGTH) block.y_length = MAX_BLOCK_LENGTH;
     if (block.textureID > 4095) block.textureID = 4095;
 
     uint64_t data = 0;
@@ -70,159 +219,191 @@ Block decodeBlock(uint64_t data) {
     return block;
 }
 
-MapSaver::MapSaver(std::fstream& f) : fileStream(&f) {}
+MapSaver::MapSaver(std::fstream& f, const std::filesystem::path& path) : fileStream(&f), filePath(path) {}
 
-void MapSaver::addBlock(Block block) {
-    uint64_t blockData = createBlock(block);
-    fileStream->seekp(0, std::ios::end);
-    fileStream->write(reinterpret_cast<const char*>(&blockData), sizeof(blockData));
-}
+void MapSaver::writeRegion(std::vector<RegionChunk> chunks) {
+    PROFILE_SCOPE("MapSaver::writeRegion");
+    std::stable_sort(chunks.begin(), chunks.end(), [](const RegionChunk& a, const RegionChunk& b) {
+        return chunkBefore(a.chunkX, a.chunkY, b.chunkX, b.chunkY);
+        });
 
-void MapSaver::sortBlocks() {
-    fileStream->flush();
-    fileStream->seekg(0, std::ios::end);
-    std::streamsize fileSize = fileStream->tellg();
+    std::vector<RegionChunkEntry> directory;
+    directory.reserve(chunks.size());
+    uint64_t firstBlock = 0;
 
-    if (fileSize <= 0) return;
+    for (const auto& chunk : chunks) {
+        if (chunk.blocks.empty()) continue;
 
-    size_t blockCount = static_cast<size_t>(fileSize) / sizeof(uint64_t);
-    std::vector<uint64_t> blocks(blockCount);
+        if (!directory.empty() && directory.back().chunkX == chunk.chunkX && directory.back().chunkY == chunk.chunkY) {
+            directory.back().blockCount += chunk.blocks.size();
+        }
+        else {
+            directory.push_back({ chunk.chunkX, chunk.chunkY, firstBlock, chunk.blocks.size() });
+        }
+        firstBlock += chunk.blocks.size();
+    }
 
-    fileStream->seekg(0, std::ios::beg);
-    fileStream->read(reinterpret_cast<char*>(blocks.data()), fileSize);
+    RegionHeader header;
+    std::memcpy(header.magic, REGION_MAGIC, sizeof(REGION_MAGIC));
+    header.version = REGION_VERSION;
+    header.chunkCount = static_cast<uint32_t>(directory.size());
 
-    std::sort(blocks.begin(), blocks.end(), sortByX);
+    // Region jest zawsze zapisywany w całości, więc plik skracamy
+    if (fileStream->is_open()) {
+        fileStream->close();
+    }
+    fileStream->open(filePath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
 
-    fileStream->seekp(0, std::ios::beg);
-    fileStream->write(reinterpret_cast<const char*>(blocks.data()),
-        static_cast<std::streamsize>(blocks.size() * sizeof(uint64_t)));
+    fileStream->write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fileStream->write(reinterpret_cast<const char*>(directory.data()),
+        static_cast<std::streamsize>(directory.size() * sizeof(RegionChunkEntry)));
+
+    for (const auto& chunk : chunks) {
+        fileStream->write(reinterpret_cast<const char*>(chunk.blocks.data()),
+            static_cast<std::streamsize>(chunk.blocks.size() * sizeof(uint64_t)));
+    }
     fileStream->flush();
 }
 
-void MapSaver::fromEditor(const std::string& jsonStr) {
-    using json = nlohmann::json;
+void MapSaver::addBlock(Block block) {
+    addBlocks({ block });
+}
 
-    try {
-        auto doc = json::parse(jsonStr);
+void MapSaver::addBlocks(const std::vector<Block>& blocks) {
+    if (blocks.empty()) return;
 
-        if (!doc.contains("chunkData")) {
-            std::cerr << "[ERROR] Brak klucza 'chunkData' w JSON" << std::endl;
-            return;
-        }
+    std::vector<RegionChunk> chunks = readRegionFile(filePath, *fileStream);
+    for (const auto& block : blocks) {
+        uint64_t blockData = createBlock(block);
+        chunks.push_back({ blockChunkX(blockData), blockChunkY(blockData), { blockData } });
+    }
 
-        const auto& chunkData = doc["chunkData"];
-        const auto& arr = chunkData["array"];
-        int chunkX = chunkData["x"].get<int>();
-        int chunkY = chunkData["y"].get<int>();
+    // writeRegion sorts stably, so appended blocks stay after the existing ones of their chunk
+    writeRegion(std::move(chunks));
+}
 
-        if (!arr.is_array() || arr.empty()) {
-            std::cerr << "[WARNING] Pusta tablica w chunku (" << chunkX << "," << chunkY << ")" << std::endl;
-            return;
-        }
+void MapSaver::sortBlocks() {
+    std::vector<RegionChunk> chunks = readRegionFile(filePath, *fileStream);
+    if (chunks.empty()) return;
+
+    for (auto& chunk : chunks) {
+        std::sort(chunk.blocks.begin(), chunk.blocks.end(), sortByX);
+    }
+    writeRegion(std::move(chunks));
+}
 
-        int blocksAdded = 0;
+MapLoader::MapLoader(std::fstream& f, const std::filesystem::path& path) : fileStream(&f), filePath(path) {}
 
-        for (size_t row = 0; row < arr.size(); ++row) {
-            for (size_t col = 0; col < arr[row].size(); ++col) {
-                const auto& item = arr[row][col];
+MapData MapLoader::loadAll() {
+    PROFILE_SCOPE("MapLoader::loadAll");
+    fileStream->flush();
 
-                EditorBlock eBlock;
-                eBlock.textureID = item.value("textureID", item.value("id", 0));
-                eBlock.collision = item.value("collision", false);
-                eBlock.damage = item.value("damage", false);
-                eBlock.layer = item.value("layer", 0);
+    MapData data;
+    FileBytes file(filePath, *fileStream);
+    RegionView view;
 
-                if (eBlock.textureID == 0 && !eBlock.collision && !eBlock.damage) {
-                    continue;
-                }
+    // Chunk data is contiguous after the directory, so the whole map decodes in one pass
+    if (parseRegion(file.data, file.size, view)) {
+        decodeRange(view.blocks, view.blockCount, data);
+    }
+    return data;
+}
 
-                int globalX = static_cast<int>(col) + (chunkX * 64);
-                int globalY = static_cast<int>(row) + (chunkY * 64);
+MapData MapLoader::loadChunks(int minChunkX, int minChunkY, int maxChunkX, int maxChunkY) {
+    PROFILE_SCOPE("MapLoader::loadChunks");
+    fileStream->flush();
 
-                Block block = editorBlockToBlock(eBlock,
-                    static_cast<uint16_t>(globalX),
-                    static_cast<uint16_t>(globalY));
+    MapData data;
+    FileBytes file(filePath, *fileStream);
+    RegionView view;
+    if (!parseRegion(file.data, file.size, view)) return data;
 
-                addBlock(block);
-                blocksAdded++;
-            }
+    if (view.legacy) {
+        for (size_t i = 0; i < view.blockCount; ++i) {
+            uint64_t blockData = readRecord(view.blocks, i);
+            int chunkX = blockChunkX(blockData);
+            int chunkY = blockChunkY(blockData);
+            if (chunkX < minChunkX || chunkX > maxChunkX || chunkY < minChunkY || chunkY > maxChunkY) continue;
+
+            data.blockCount++;
+            decodeInto(blockData, data);
         }
+        return data;
+    }
 
-        fileStream->flush();
-        std::cout << "[MAP] Chunk (" << chunkX << "," << chunkY << ") -> " << blocksAdded << " bloków" << std::endl;
+    for (int chunkY = minChunkY; chunkY <= maxChunkY; ++chunkY) {
+        auto it = std::lower_bound(view.directory.begin(), view.directory.end(), std::make_pair(minChunkX, chunkY),
+            [](const RegionChunkEntry& entry, const std::pair<int, int>& key) {
+                return chunkBefore(entry.chunkX, entry.chunkY, key.first, key.second);
+            });
 
+        for (; it != view.directory.end() && it->chunkY == chunkY && it->chunkX <= maxChunkX; ++it) {
+            decodeRange(view.blocks + it->firstBlock * sizeof(uint64_t), static_cast<size_t>(it->blockCount), data);
+        }
     }
-    catch (const std::exception& e) {
-        std::cerr << "[ERROR] fromEditor: " << e.what() << std::endl;
-    }
+    return data;
 }
 
-MapLoader::MapLoader(std::fstream& f) : fileStream(&f) {}
+MapData MapLoader::loadChunk(int chunkX, int chunkY) {
+    return loadChunks(chunkX, chunkY, chunkX, chunkY);
+}
 
-std::vector<CollisionRect> MapLoader::getCollisions() {
-    fileStream->clear();
-    fileStream->seekg(0, std::ios::beg);
+std::vector<RegionChunk> MapLoader::readRegion() {
+    return readRegionFile(filePath, *fileStream);
+}
 
-    std::vector<CollisionRect> collisions;
-    uint64_t blockData;
+std::vector<std::pair<int, int>> MapLoader::listChunks() {
+    fileStream->flush();
 
-    while (fileStream->read(reinterpret_cast<char*>(&blockData), sizeof(blockData))) {
-        Block block = decodeBlock(blockData);
-        if (block.extraData == ExtraData::COLLIDABLE) {
-            collisions.emplace_back(
-                block.x * TILE_SIZE,
-                block.y * TILE_SIZE,
-                block.x_length * TILE_SIZE,
-                block.y_length * TILE_SIZE
-            );
+    std::vector<std::pair<int, int>> chunks;
+    FileBytes file(filePath, *fileStream);
+    RegionView view;
+    if (!parseRegion(file.data, file.size, view)) return chunks;
+
+    if (!view.legacy) {
+        chunks.reserve(view.directory.size());
+        for (const auto& entry : view.directory) {
+            if (entry.blockCount > 0) chunks.emplace_back(entry.chunkX, entry.chunkY);
         }
+        return chunks;
     }
 
-    fileStream->clear();
-    return collisions;
+    for (size_t i = 0; i < view.blockCount; ++i) {
+        uint64_t blockData = readRecord(view.blocks, i);
+        chunks.emplace_back(blockChunkX(blockData), blockChunkY(blockData));
+    }
+    std::sort(chunks.begin(), chunks.end());
+    chunks.erase(std::unique(chunks.begin(), chunks.end()), chunks.end());
+    return chunks;
 }
 
-std::vector<CollisionRect> MapLoader::getDamagingZones() {
-    fileStream->clear();
-    fileStream->seekg(0, std::ios::beg);
-
-    std::vector<CollisionRect> zones;
-    uint64_t blockData;
+size_t MapLoader::getBlockCount() {
+    fileStream->flush();
 
-    while (fileStream->read(reinterpret_cast<char*>(&blockData), sizeof(blockData))) {
-        Block block = decodeBlock(blockData);
-        if (block.extraData == ExtraData::DAMAGING) {
-            zones.emplace_back(
-                block.x * TILE_SIZE,
-                block.y * TILE_SIZE,
-                block.x_length * TILE_SIZE,
-                block.y_length * TILE_SIZE
-            );
-        }
+    std::error_code ec;
+    auto size = std::filesystem::file_size(filePath, ec);
+    if (ec) return 0;
+
+    // Only the header is needed: the blocks fill everything after the directory
+    RegionHeader header;
+    std::ifstream file(filePath, std::ios::binary);
+    if (size >= sizeof(header) && file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        && std::memcmp(header.magic, REGION_MAGIC, sizeof(REGION_MAGIC)) == 0) {
+        uint64_t dataStart = sizeof(header) + static_cast<uint64_t>(header.chunkCount) * sizeof(RegionChunkEntry);
+        return size > dataStart ? static_cast<size_t>((size - dataStart) / sizeof(uint64_t)) : 0;
     }
 
-    fileStream->clear();
-    return zones;
+    return static_cast<size_t>(size) / sizeof(uint64_t);
 }
 
-std::vector<RenderTile> MapLoader::getRenderData() {
-    fileStream->clear();
-    fileStream->seekg(0, std::ios::beg);
-
-    std::vector<RenderTile> tiles;
-    uint64_t blockData;
+std::vector<CollisionRect> MapLoader::getCollisions() {
+    return loadAll().collisions;
+}
 
-    while (fileStream->read(reinterpret_cast<char*>(&blockData), sizeof(blockData))) {
-        Block block = decodeBlock(blockData);
-        if (block.textureID > 0) {
-            tiles.push_back({
-                block.x * TILE_SIZE,
-                block.y * TILE_SIZE,
-                block.textureID
-                });
-        }
-    }
+std::vector<CollisionRect> MapLoader::getDamagingZones() {
+    return loadAll().damagingZones;
+}
 
-    fileStream->clear();
-    return tiles;
-}
\ No newline at end of file
+std::vector<RenderTile> MapLoader::getRenderData() {
+    return loadAll().renderTiles;
+}
@@ -1,16 +1,22 @@
 #pragma once
 #include <string>
 #include <fstream>
+#include <filesystem>
 #include <vector>
 #include <cstdint>
+#include <utility>
 
 const int TILE_SIZE = 8;
+const int MAX_BLOCK_LENGTH = 63;
+// Side of a map chunk in tiles, same as the level editor's chunk files
+const int CHUNK_SIZE = 64;
 
 enum class Layers : uint8_t {
     BACKGROUND = 0,
     MIDGROUND = 1,
     FOREGROUND = 2
 };
+const int LAYER_COUNT = 3;
 
 enum class ExtraData : uint8_t {
     NONE = 0,
@@ -36,32 +42,98 @@ struct CollisionRect {
 struct RenderTile {
     int x, y;
     uint16_t textureID;
+    Layers layer;
+};
+
+struct MapData {
+    std::vector<CollisionRect> collisions;
+    std::vector<CollisionRect> damagingZones;
+    std::vector<RenderTile> renderTiles;
+    size_t blockCount = 0;
 };
 
 uint64_t createBlock(Block block);
 Block decodeBlock(uint64_t blockData);
 
+// map.bin region layout: RegionHeader, chunkCount RegionChunkEntry records sorted by
+// (chunkY, chunkX), then the packed blocks of every chunk back to back in directory order.
+// A file without the magic is the old headerless block stream and is still readable.
+constexpr char REGION_MAGIC[8] = { 'P', 'A', 'P', 'Y', 'R', 'G', 'N', '\0' };
+constexpr uint32_t REGION_VERSION = 1;
+
+struct RegionHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t chunkCount;
+};
+
+struct RegionChunkEntry {
+    int32_t chunkX;
+    int32_t chunkY;
+    uint64_t firstBlock;
+    uint64_t blockCount;
+};
+
+static_assert(sizeof(RegionHeader) == 16 && sizeof(RegionChunkEntry) == 24, "Region layout must not be padded");
+
+struct RegionChunk {
+    int chunkX = 0;
+    int chunkY = 0;
+    std::vector<uint64_t> blocks;
+};
+
+// Chunk coordinates packed into one key: X in the high half, Y in the low half.
+using ChunkKey = int64_t;
+
+inline ChunkKey makeChunkKey(int chunkX, int chunkY) {
+    return (static_cast<int64_t>(chunkX) << 32) | static_cast<uint32_t>(chunkY);
+}
+inline int chunkKeyX(ChunkKey key) { return static_cast<int>(key >> 32); }
+inline int chunkKeyY(ChunkKey key) { return static_cast<int32_t>(key & 0xFFFFFFFF); }
+
+// Chunk holding the given tile coordinate, rounding toward negative infinity
+int tileToChunk(int tile);
+int blockChunkX(uint64_t blockData);
+int blockChunkY(uint64_t blockData);
+
 class MapSaver {
 private:
     std::fstream* fileStream;
+    std::filesystem::path filePath;
 
 public:
-    explicit MapSaver(std::fstream& f);
+    MapSaver(std::fstream& f, const std::filesystem::path& path);
     ~MapSaver() = default;
 
+    // Rewrites the whole file in the region layout; chunks may come in any order.
+    void writeRegion(std::vector<RegionChunk> chunks);
+
     void addBlock(Block block);
+    void addBlocks(const std::vector<Block>& blocks);
+    // Orders blocks inside every chunk by signed X, then Y
     void sortBlocks();
-    void fromEditor(const std::string& jsonStr);
 };
 
 class MapLoader {
 private:
     std::fstream* fileStream;
+    std::filesystem::path filePath;
 
 public:
-    explicit MapLoader(std::fstream& f);
+    MapLoader(std::fstream& f, const std::filesystem::path& path);
     ~MapLoader() = default;
 
+    // Decodes every block in a single pass over a memory mapping of the file.
+    MapData loadAll();
+    // Only the chunks inside the inclusive chunk rectangle, found through the directory.
+    MapData loadChunks(int minChunkX, int minChunkY, int maxChunkX, int maxChunkY);
+    MapData loadChunk(int chunkX, int chunkY);
+    // Raw blocks grouped per chunk; legacy files are grouped on the fly.
+    std::vector<RegionChunk> readRegion();
+    // Coordinates of every chunk that holds blocks, as (chunkX, chunkY)
+    std::vector<std::pair<int, int>> listChunks();
+    size_t getBlockCount();
+
     std::vector<CollisionRect> getCollisions();
     std::vector<CollisionRect> getDamagingZones();
     std::vector<RenderTile> getRenderData();
@@ -0,0 +1,105 @@
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+    mFileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        close();
+        return;
+    }
+
+    mSize = static_cast<size_t>(fileSize.QuadPart);
+    if (mSize == 0) {
+        mOpen = true;
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        close();
+        return;
+    }
+    mMappingHandle = mapping;
+
+    mData = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!mData) {
+        close();
+        return;
+    }
+
+    mOpen = true;
+}
+
+void MappedFile::close() {
+    if (mData) UnmapViewOfFile(mData);
+    if (mMappingHandle) CloseHandle(static_cast<HANDLE>(mMappingHandle));
+    if (mFileHandle) CloseHandle(static_cast<HANDLE>(mFileHandle));
+
+    mData = nullptr;
+    mMappingHandle = nullptr;
+    mFileHandle = nullptr;
+    mSize = 0;
+    mOpen = false;
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    mFd = ::open(path.c_str(), O_RDONLY);
+    if (mFd < 0) return;
+
+    struct stat st;
+    if (fstat(mFd, &st) != 0) {
+        close();
+        return;
+    }
+
+    mSize = static_cast<size_t>(st.st_size);
+    if (mSize == 0) {
+        mOpen = true;
+        return;
+    }
+
+    void* ptr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, mFd, 0);
+    if (ptr == MAP_FAILED) {
+        close();
+        return;
+    }
+
+    madvise(ptr, mSize, MADV_SEQUENTIAL);
+    mData = static_cast<const uint8_t*>(ptr);
+    mOpen = true;
+}
+
+void MappedFile::close() {
+    if (mData) munmap(const_cast<uint8_t*>(mData), mSize);
+    if (mFd >= 0) ::close(mFd);
+
+    mData = nullptr;
+    mFd = -1;
+    mSize = 0;
+    mOpen = false;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// Read-only memory mapping of a whole file. An empty file counts as open with size 0.
+class MappedFile {
+private:
+    const uint8_t* mData = nullptr;
+    size_t mSize = 0;
+    bool mOpen = false;
+
+#ifdef _WIN32
+    void* mFileHandle = nullptr;
+    void* mMappingHandle = nullptr;
+#else
+    int mFd = -1;
+#endif
+
+    void close();
+
+public:
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return mOpen; }
+    const uint8_t* data() const { return mData; }
+    size_t size() const { return mSize; }
+};
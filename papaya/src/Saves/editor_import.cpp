@@ -0,0 +1,483 @@
+#include "editor_import.hpp"
+#include "../Core/Profiler.hpp"
+#include "../Core/ThreadPool.hpp"
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+namespace {
+    // 2: block ranges replaced by per-chunk counts in the map.bin region directory
+    constexpr int MANIFEST_VERSION = 2;
+
+    struct EditorBlock {
+        int textureID = 0;
+        bool collision = false;
+        bool damage = false;
+        int layer = 0;
+    };
+
+    ExtraData editorBlockKind(const EditorBlock& eBlock) {
+        if (eBlock.collision) return ExtraData::COLLIDABLE;
+        if (eBlock.damage) return ExtraData::DAMAGING;
+        return ExtraData::NONE;
+    }
+
+    // Render-only block; collision and damage are written separately as merged rectangles
+    Block editorBlockToBlock(const EditorBlock& eBlock, uint16_t x, uint16_t y) {
+        Block block;
+        block.x = static_cast<int16_t>(x);
+        block.y = static_cast<int16_t>(y);
+        block.x_length = 1;
+        block.y_length = 1;
+        block.textureID = static_cast<uint16_t>(eBlock.textureID);
+        block.extraData = ExtraData::NONE;
+        block.layer = static_cast<Layers>(eBlock.layer);
+
+        return block;
+    }
+
+    // Greedy meshing: grow each unclaimed tile of the given kind right, then down,
+    // into the largest rectangle the 6-bit length fields can hold.
+    void mergeTileRects(const std::vector<ExtraData>& kinds, int cols, int rows, ExtraData kind,
+        int originX, int originY, std::vector<Block>& out) {
+        std::vector<uint8_t> claimed(kinds.size(), 0);
+
+        auto isFree = [&](int x, int y) {
+            int i = y * cols + x;
+            return kinds[i] == kind && !claimed[i];
+            };
+
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < cols; ++x) {
+                if (!isFree(x, y)) continue;
+
+                int w = 1;
+                while (x + w < cols && w < MAX_BLOCK_LENGTH && isFree(x + w, y)) w++;
+
+                int h = 1;
+                while (y + h < rows && h < MAX_BLOCK_LENGTH) {
+                    bool rowFits = true;
+                    for (int i = 0; i < w; ++i) {
+                        if (!isFree(x + i, y + h)) {
+                            rowFits = false;
+                            break;
+                        }
+                    }
+                    if (!rowFits) break;
+                    h++;
+                }
+
+                for (int dy = 0; dy < h; ++dy) {
+                    for (int dx = 0; dx < w; ++dx) {
+                        claimed[(y + dy) * cols + (x + dx)] = 1;
+                    }
+                }
+
+                Block block;
+                block.x = static_cast<int16_t>(originX + x);
+                block.y = static_cast<int16_t>(originY + y);
+                block.x_length = static_cast<uint8_t>(w);
+                block.y_length = static_cast<uint8_t>(h);
+                block.textureID = 0;
+                block.extraData = kind;
+                block.layer = Layers::BACKGROUND;
+                out.push_back(block);
+            }
+        }
+    }
+
+    EntityType editorEntityType(int editorID, int& unknownCount) {
+        switch (editorID) {
+        case 1: return RABBIT;
+        case 2: return MAGE_BOSS;
+        default:
+            unknownCount++;
+            return RABBIT;
+        }
+    }
+
+    // Streams the fixed chunkData schema straight into records, without building a DOM.
+    // Tiles and entities are collected in chunk-local coordinates because "x" and "y"
+    // may come after the arrays; finish() offsets them once the whole chunk was read.
+    class ChunkSaxHandler : public nlohmann::json_sax<nlohmann::json> {
+    public:
+        explicit ChunkSaxHandler(ChunkImport& out) : mOut(out) {}
+
+        bool null() override { return onOther(); }
+        bool boolean(bool val) override { return onNumber(val ? 1 : 0); }
+        bool number_integer(number_integer_t val) override { return onNumber((long long)val); }
+        bool number_unsigned(number_unsigned_t val) override { return onNumber((long long)val); }
+        bool number_float(number_float_t val, const string_t&) override { return onNumber((long long)val); }
+        bool string(string_t&) override { return onOther(); }
+        bool binary(binary_t&) override { return onOther(); }
+
+        bool key(string_t& val) override {
+            mKey = val;
+            return true;
+        }
+
+        bool start_object(std::size_t) override {
+            Context parent = top();
+            Context ctx = Context::OTHER;
+
+            if (mStack.empty()) ctx = Context::ROOT;
+            else if (parent == Context::ROOT && mKey == "chunkData") {
+                ctx = Context::CHUNK;
+                mHasChunkData = true;
+            }
+            else if (parent == Context::TILE_ROW) {
+                ctx = Context::TILE;
+                mTile = EditorBlock();
+                mTileHasTextureID = false;
+                mTileLegacyID = 0;
+            }
+            else onOther();
+
+            mStack.push_back(ctx);
+            return true;
+        }
+
+        bool end_object() override {
+            if (top() == Context::TILE) {
+                if (!mTileHasTextureID) mTile.textureID = mTileLegacyID;
+
+                int col = mRowLength++;
+                int row = mRows - 1;
+                mKinds.push_back(editorBlockKind(mTile));
+                if (mTile.textureID != 0) mLocalTiles.push_back({ col, row, mTile });
+            }
+            mStack.pop_back();
+            return true;
+        }
+
+        bool start_array(std::size_t) override {
+            Context parent = top();
+            Context ctx = Context::OTHER;
+
+            if (parent == Context::CHUNK && mKey == "array") ctx = Context::TILE_ROWS;
+            else if (parent == Context::CHUNK && mKey == "entities") ctx = Context::ENTITY_ROWS;
+            else if (parent == Context::TILE_ROWS) {
+                ctx = Context::TILE_ROW;
+                mRows++;
+                mRowLength = 0;
+            }
+            else if (parent == Context::ENTITY_ROWS) {
+                ctx = Context::ENTITY_ROW;
+                mEntityRows++;
+                mEntityCol = 0;
+            }
+            else onOther();
+
+            mStack.push_back(ctx);
+            return true;
+        }
+
+        bool end_array() override {
+            if (top() == Context::TILE_ROW) {
+                mRowLengths.push_back(mRowLength);
+            }
+            mStack.pop_back();
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+            mOut.error = ex.what();
+            return false;
+        }
+
+        bool finish() {
+            if (!mHasChunkData) {
+                mOut.error = "Brak klucza 'chunkData' w JSON";
+                return false;
+            }
+            // Bez współrzędnych chunk trafiłby na (0,0) i nadpisał spawn
+            if (!mHasX || !mHasY) {
+                mOut.error = "Brak klucza 'x' lub 'y' w chunkData";
+                return false;
+            }
+
+            int originX = mOut.chunkX * CHUNK_SIZE;
+            int originY = mOut.chunkY * CHUNK_SIZE;
+
+            mOut.blocks.reserve(mLocalTiles.size());
+            for (const auto& t : mLocalTiles) {
+                mOut.blocks.push_back(editorBlockToBlock(t.block,
+                    static_cast<uint16_t>(originX + t.col),
+                    static_cast<uint16_t>(originY + t.row)));
+            }
+            mOut.tileBlocks = mOut.blocks.size();
+
+            // Wiersze mogą mieć różną długość - dopełniamy do prostokąta
+            int cols = 0;
+            for (int len : mRowLengths) cols = std::max(cols, len);
+            std::vector<ExtraData> kinds(static_cast<size_t>(mRows) * cols, ExtraData::NONE);
+            size_t src = 0;
+            for (int row = 0; row < (int)mRowLengths.size(); ++row) {
+                for (int col = 0; col < mRowLengths[row]; ++col) kinds[row * cols + col] = mKinds[src++];
+            }
+
+            mergeTileRects(kinds, cols, mRows, ExtraData::COLLIDABLE, originX, originY, mOut.blocks);
+            mergeTileRects(kinds, cols, mRows, ExtraData::DAMAGING, originX, originY, mOut.blocks);
+
+            for (auto& entity : mOut.entities) {
+                entity.x = static_cast<int16_t>(entity.x + originX);
+                entity.y = static_cast<int16_t>(entity.y + originY);
+            }
+
+            return true;
+        }
+
+    private:
+        enum class Context : uint8_t { ROOT, CHUNK, TILE_ROWS, TILE_ROW, TILE, ENTITY_ROWS, ENTITY_ROW, OTHER };
+
+        struct LocalTile {
+            int col;
+            int row;
+            EditorBlock block;
+        };
+
+        ChunkImport& mOut;
+        std::vector<Context> mStack;
+        std::string mKey;
+        bool mHasChunkData = false;
+        bool mHasX = false;
+        bool mHasY = false;
+
+        EditorBlock mTile;
+        bool mTileHasTextureID = false;
+        int mTileLegacyID = 0;
+
+        int mRows = 0;
+        int mRowLength = 0;
+        std::vector<int> mRowLengths;
+        std::vector<ExtraData> mKinds;
+        std::vector<LocalTile> mLocalTiles;
+
+        int mEntityRows = 0;
+        int mEntityCol = 0;
+
+        Context top() const { return mStack.empty() ? Context::OTHER : mStack.back(); }
+
+        void emptyTileCell() {
+            mRowLength++;
+            mKinds.push_back(ExtraData::NONE);
+        }
+
+        // null, strings and nested containers still take a cell, so later columns stay aligned
+        bool onOther() {
+            if (top() == Context::TILE_ROW) emptyTileCell();
+            else if (top() == Context::ENTITY_ROW) mEntityCol++;
+            return true;
+        }
+
+        bool onNumber(long long val) {
+            switch (top()) {
+            case Context::CHUNK:
+                if (mKey == "x") {
+                    mOut.chunkX = (int)val;
+                    mHasX = true;
+                }
+                else if (mKey == "y") {
+                    mOut.chunkY = (int)val;
+                    mHasY = true;
+                }
+                break;
+            case Context::TILE_ROW:
+                emptyTileCell();
+                break;
+            case Context::TILE:
+                if (mKey == "textureID") {
+                    mTile.textureID = (int)val;
+                    mTileHasTextureID = true;
+                }
+                else if (mKey == "id") mTileLegacyID = (int)val;
+                else if (mKey == "collision") mTile.collision = val != 0;
+                else if (mKey == "damage") mTile.damage = val != 0;
+                else if (mKey == "layer") mTile.layer = (int)val;
+                break;
+            case Context::ENTITY_ROW: {
+                int col = mEntityCol++;
+                if (val == 0) break;
+
+                EntityS entity;
+                entity.x = static_cast<int16_t>(col);
+                entity.y = static_cast<int16_t>(mEntityRows - 1);
+                entity.entityType = editorEntityType((int)val, mOut.unknownEntities);
+                entity.health = 10;
+                mOut.entities.push_back(entity);
+                break;
+            }
+            default:
+                break;
+            }
+            return true;
+        }
+    };
+
+    template<typename Input>
+    ChunkImport runChunkSax(Input&& input) {
+        PROFILE_SCOPE("importEditorChunk");
+        ChunkImport chunk;
+        try {
+            ChunkSaxHandler handler(chunk);
+            if (nlohmann::json::sax_parse(std::forward<Input>(input), &handler)) {
+                chunk.ok = handler.finish();
+            }
+        }
+        catch (const std::exception& e) {
+            chunk.error = e.what();
+        }
+        return chunk;
+    }
+
+    ChunkImport importEditorFile(const std::filesystem::path& file) {
+        PROFILE_SCOPE("importEditorFile");
+        std::ifstream jsonFile(file, std::ios::binary);
+        if (!jsonFile.is_open()) {
+            ChunkImport failed;
+            failed.source = file;
+            failed.error = "Nie można otworzyć pliku";
+            return failed;
+        }
+
+        ChunkImport chunk = importEditorChunk(jsonFile);
+        chunk.source = file;
+        return chunk;
+    }
+}
+
+ChunkImport importEditorChunk(const std::string& jsonStr) {
+    return runChunkSax(jsonStr);
+}
+
+ChunkImport importEditorChunk(std::istream& input) {
+    return runChunkSax(input);
+}
+
+std::vector<std::filesystem::path> listEditorChunks(const std::filesystem::path& editorDir) {
+    std::vector<std::filesystem::path> files;
+
+    for (const auto& entry : std::filesystem::directory_iterator(editorDir)) {
+        if (entry.path().extension() != ".json") continue;
+
+        std::string filename = entry.path().filename().string();
+        if (filename.find("autosave") != std::string::npos) {
+            std::cout << "[SYSTEM] Pominieto plik autozapisu: " << filename << std::endl;
+            continue;
+        }
+        files.push_back(entry.path());
+    }
+
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+std::vector<ChunkImport> importEditorChunks(const std::vector<std::filesystem::path>& files) {
+    std::vector<std::future<ChunkImport>> pending;
+    pending.reserve(files.size());
+
+    ThreadPool& pool = ThreadPool::shared();
+    for (const auto& file : files) {
+        pending.push_back(pool.submit([file]() { return importEditorFile(file); }));
+    }
+
+    std::vector<ChunkImport> chunks;
+    chunks.reserve(files.size());
+    for (auto& result : pending) chunks.push_back(result.get());
+    return chunks;
+}
+
+bool ImportManifest::load(const std::filesystem::path& path) {
+    chunks.clear();
+
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    try {
+        auto doc = nlohmann::json::parse(file);
+        if (doc.value("version", 0) != MANIFEST_VERSION) return false;
+
+        for (const auto& item : doc.at("chunks")) {
+            ManifestEntry entry;
+            entry.file = item.at("file").get<std::string>();
+            entry.modTime = item.at("modTime").get<int64_t>();
+            entry.contentHash = item.at("hash").get<uint64_t>();
+            entry.chunkX = item.at("chunkX").get<int>();
+            entry.chunkY = item.at("chunkY").get<int>();
+            entry.blockCount = item.at("blockCount").get<uint64_t>();
+            entry.entityOffset = item.at("entityOffset").get<uint64_t>();
+            entry.entityCount = item.at("entityCount").get<uint64_t>();
+            chunks.push_back(entry);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[WARNING] Uszkodzony manifest importu: " << e.what() << std::endl;
+        chunks.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool ImportManifest::save(const std::filesystem::path& path) const {
+    nlohmann::json doc;
+    doc["version"] = MANIFEST_VERSION;
+    doc["chunks"] = nlohmann::json::array();
+
+    for (const auto& entry : chunks) {
+        doc["chunks"].push_back({
+            { "file", entry.file },
+            { "modTime", entry.modTime },
+            { "hash", entry.contentHash },
+            { "chunkX", entry.chunkX },
+            { "chunkY", entry.chunkY },
+            { "blockCount", entry.blockCount },
+            { "entityOffset", entry.entityOffset },
+            { "entityCount", entry.entityCount }
+        });
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) return false;
+    file << doc.dump(1);
+    return true;
+}
+
+ManifestEntry* ImportManifest::find(const std::string& file) {
+    for (auto& entry : chunks) {
+        if (entry.file == file) return &entry;
+    }
+    return nullptr;
+}
+
+const ManifestEntry* ImportManifest::find(const std::string& file) const {
+    for (const auto& entry : chunks) {
+        if (entry.file == file) return &entry;
+    }
+    return nullptr;
+}
+
+int64_t fileModTime(const std::filesystem::path& file) {
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time(file, ec);
+    if (ec) return 0;
+    return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+uint64_t hashFileContents(const std::filesystem::path& file) {
+    std::ifstream input(file, std::ios::binary);
+    uint64_t hash = 14695981039346656037ULL;
+
+    char buffer[64 * 1024];
+    while (input) {
+        input.read(buffer, sizeof(buffer));
+        std::streamsize count = input.gcount();
+        for (std::streamsize i = 0; i < count; ++i) {
+            hash ^= static_cast<uint8_t>(buffer[i]);
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash;
+}
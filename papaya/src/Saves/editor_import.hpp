@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include <vector>
+#include "Map/map.hpp"
+#include "Entities/entities.hpp"
+
+// Save records produced from one editor chunk file (chunk-X-Y.json).
+struct ChunkImport {
+    std::filesystem::path source;
+    int chunkX = 0;
+    int chunkY = 0;
+    bool ok = false;
+    std::string error;
+
+    // Render tiles first, then merged collision and damage rectangles
+    std::vector<Block> blocks;
+    size_t tileBlocks = 0;
+
+    std::vector<EntityS> entities;
+    int unknownEntities = 0;
+};
+
+// What the last import took from each chunk file: its block count in the map.bin
+// region and its range in entities.bin, so unchanged chunks can be copied instead of re-imported.
+struct ManifestEntry {
+    std::string file;
+    int64_t modTime = 0;
+    uint64_t contentHash = 0;
+    int chunkX = 0;
+    int chunkY = 0;
+    uint64_t blockCount = 0;
+    uint64_t entityOffset = 0;
+    uint64_t entityCount = 0;
+};
+
+struct ImportManifest {
+    std::vector<ManifestEntry> chunks;
+
+    bool load(const std::filesystem::path& path);
+    bool save(const std::filesystem::path& path) const;
+    ManifestEntry* find(const std::string& file);
+    const ManifestEntry* find(const std::string& file) const;
+};
+
+int64_t fileModTime(const std::filesystem::path& file);
+// FNV-1a over the file contents, read in fixed-size pieces.
+uint64_t hashFileContents(const std::filesystem::path& file);
+
+// Streams the chunk JSON once (SAX, no DOM) and converts both tiles and entities.
+ChunkImport importEditorChunk(const std::string& jsonStr);
+ChunkImport importEditorChunk(std::istream& input);
+
+// Editor chunk files in a stable order, autosaves skipped.
+std::vector<std::filesystem::path> listEditorChunks(const std::filesystem::path& editorDir);
+
+// Reads and converts the files on the shared thread pool; results keep the order of `files`.
+std::vector<ChunkImport> importEditorChunks(const std::vector<std::filesystem::path>& files);
@@ -1,5 +1,9 @@
 ﻿#include "saves.hpp"
+#include "editor_import.hpp"
+#include "../Core/Profiler.hpp"
 #include <iostream>
+#include <map>
+#include <set>
 
 void Saves::openFile(std::fstream& file, const std::filesystem::path& filePath) {
     file.open(filePath, std::ios::in | std::ios::out | std::ios::binary);
@@ -21,8 +25,8 @@ Saves::Saves(const std::string& pathToFolder) : path(pathToFolder) {
     openFile(entitiesSaveFile, path / "saves.bin");
 
     if (mapFile.is_open()) {
-        mapLoader = std::make_unique<MapLoader>(mapFile);
-        mapSaver = std::make_unique<MapSaver>(mapFile);
+        mapLoader = std::make_unique<MapLoader>(mapFile, path / "map.bin");
+        mapSaver = std::make_unique<MapSaver>(mapFile, path / "map.bin");
     }
 
     if (entitiesFile.is_open()) {
@@ -92,44 +96,204 @@ void Saves::clearSaveData() {
     entitySavesSaver = std::make_unique<EntitySaver>(entitiesSaveFile);
 }
 
-void Saves::loadFromEditorDir(const std::string& pathToFolder) {
+std::vector<uint64_t> Saves::readRecords(std::fstream& file) {
+    std::vector<uint64_t> records;
+    if (!file.is_open()) return records;
+
+    file.flush();
+    file.clear();
+    file.seekg(0, std::ios::end);
+    std::streamsize size = file.tellg();
+    if (size <= 0) return records;
+
+    records.resize(static_cast<size_t>(size) / sizeof(uint64_t));
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char*>(records.data()),
+        static_cast<std::streamsize>(records.size() * sizeof(uint64_t)));
+    file.clear();
+    return records;
+}
+
+void Saves::rewriteFile(std::fstream& file, const std::filesystem::path& filePath, const std::vector<uint64_t>& records) {
+    if (file.is_open()) {
+        file.close();
+    }
+    file.open(filePath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!records.empty()) {
+        file.write(reinterpret_cast<const char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(uint64_t)));
+    }
+}
+
+std::vector<std::pair<int, int>> Saves::loadFromEditorDir(const std::string& pathToFolder) {
+    PROFILE_SCOPE("Saves::loadFromEditorDir");
     std::filesystem::path editorPath(pathToFolder);
+    std::vector<std::pair<int, int>> changedChunks;
 
     if (!std::filesystem::exists(editorPath)) {
         std::cerr << "[ERROR] Folder nie istnieje: " << pathToFolder << std::endl;
-        return;
+        return changedChunks;
     }
 
-    std::cout << "[SYSTEM] Import z '" << pathToFolder << "'..." << std::endl;
+    std::cout << "[SYSTEM] Synchronizacja z '" << pathToFolder << "'..." << std::endl;
+
+    std::map<std::pair<int, int>, std::vector<uint64_t>> oldChunks;
+    size_t oldBlockCount = 0;
+    if (mapLoader) {
+        for (auto& chunk : mapLoader->readRegion()) {
+            oldBlockCount += chunk.blocks.size();
+            oldChunks[{ chunk.chunkX, chunk.chunkY }] = std::move(chunk.blocks);
+        }
+    }
+    std::vector<uint64_t> oldEntities = readRecords(entitiesFile);
 
-    for (const auto& entry : std::filesystem::directory_iterator(editorPath)) {
-        if (entry.path().extension() == ".json") {
+    std::set<std::pair<int, int>> removedChunks;
+    for (const auto& [key, blocks] : oldChunks) removedChunks.insert(key);
 
-            std::string filename = entry.path().filename().string();
-            if (filename.find("autosave") != std::string::npos) {
-                std::cout << "[SYSTEM] Pominieto plik autozapisu: " << filename << std::endl;
-                continue;
+    // Manifest musi dokładnie pokrywać obecne pliki, inaczej pełny import
+    ImportManifest manifest;
+    bool manifestValid = manifest.load(path / "import_manifest.json");
+    if (manifestValid) {
+        uint64_t blockTotal = 0, entityEnd = 0;
+        for (const auto& entry : manifest.chunks) {
+            auto it = oldChunks.find({ entry.chunkX, entry.chunkY });
+            size_t regionCount = it != oldChunks.end() ? it->second.size() : 0;
+            if (regionCount != entry.blockCount || entry.entityOffset != entityEnd) {
+                manifestValid = false;
+                break;
             }
+            blockTotal += entry.blockCount;
+            entityEnd += entry.entityCount;
+        }
+        if (blockTotal != oldBlockCount || entityEnd != oldEntities.size()) manifestValid = false;
+    }
+    if (!manifestValid) {
+        if (oldBlockCount > 0 || !oldEntities.empty()) {
+            std::cout << "[SYSTEM] Brak aktualnego manifestu - pełny import" << std::endl;
+        }
+        manifest.chunks.clear();
+        oldChunks.clear();
+        oldEntities.clear();
+    }
 
-            std::ifstream jsonFile(entry.path());
-            if (jsonFile.is_open()) {
-                std::string content(
-                    (std::istreambuf_iterator<char>(jsonFile)),
-                    std::istreambuf_iterator<char>()
-                );
-                jsonFile.close();
+    std::vector<std::filesystem::path> files = listEditorChunks(editorPath);
+    std::vector<ManifestEntry*> previous(files.size(), nullptr);
+    std::vector<int64_t> modTimes(files.size(), 0);
+    std::vector<uint64_t> hashes(files.size(), 0);
+    std::vector<std::filesystem::path> changed;
+    bool removed = files.size() != manifest.chunks.size();
+    bool touched = false;
 
-                if (mapSaver) {
-                    mapSaver->fromEditor(content);
-                }
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::string name = files[i].filename().string();
+        ManifestEntry* entry = manifest.find(name);
+        modTimes[i] = fileModTime(files[i]);
+
+        if (entry && entry->modTime == modTimes[i]) {
+            previous[i] = entry;
+            hashes[i] = entry->contentHash;
+            continue;
+        }
+
+        // Zmieniona data, ale ta sama treść (np. zapis bez zmian w edytorze)
+        hashes[i] = hashFileContents(files[i]);
+        if (entry && entry->contentHash == hashes[i]) {
+            previous[i] = entry;
+            touched = true;
+            continue;
+        }
 
-                if (entitySaver) {
-                    entitySaver->fromEditor(content);
+        changed.push_back(files[i]);
+    }
+
+    if (changed.empty() && !removed) {
+        // Same daty do odświeżenia - map.bin i entities.bin zostają bez zmian
+        if (touched) {
+            for (size_t i = 0; i < files.size(); ++i) {
+                previous[i]->modTime = modTimes[i];
+            }
+            manifest.save(path / "import_manifest.json");
+        }
+        std::cout << "[SYSTEM] Mapa aktualna, " << files.size() << " chunków bez zmian." << std::endl;
+        return changedChunks;
+    }
+
+    std::vector<ChunkImport> imported = importEditorChunks(changed);
+    size_t nextImport = 0;
+
+    // Niezmienione chunki i zakresy encji kopiowane, zmienione z importu
+    std::vector<RegionChunk> region;
+    std::vector<uint64_t> entities;
+    ImportManifest updated;
+    region.reserve(files.size());
+    entities.reserve(oldEntities.size());
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::string name = files[i].filename().string();
+        ManifestEntry entry;
+
+        if (previous[i]) {
+            entry = *previous[i];
+        }
+        else {
+            const ChunkImport& chunk = imported[nextImport++];
+            const ManifestEntry* old = manifest.find(name);
+
+            if (!chunk.ok) {
+                std::cerr << "[ERROR] Import " << name << ": " << chunk.error << std::endl;
+                // Poprzednia wersja zostaje, następna synchronizacja spróbuje ponownie
+                if (!old) continue;
+                entry = *old;
+            }
+            else {
+                std::cout << "[MAP] Chunk (" << chunk.chunkX << "," << chunk.chunkY << ") -> " << chunk.tileBlocks << " kafelków, "
+                    << (chunk.blocks.size() - chunk.tileBlocks) << " prostokątów kolizji, " << chunk.entities.size() << " encji" << std::endl;
+                if (chunk.unknownEntities > 0) {
+                    std::cout << " -> WARNING: " << chunk.unknownEntities << " encji z nieznanym ID, ustawiam RABBIT" << std::endl;
                 }
+
+                entry.file = name;
+                entry.modTime = modTimes[i];
+                entry.contentHash = hashes[i];
+                entry.chunkX = chunk.chunkX;
+                entry.chunkY = chunk.chunkY;
+                entry.blockCount = chunk.blocks.size();
+                entry.entityOffset = entities.size();
+                entry.entityCount = chunk.entities.size();
+
+                changedChunks.emplace_back(chunk.chunkX, chunk.chunkY);
+                removedChunks.erase({ chunk.chunkX, chunk.chunkY });
+
+                RegionChunk regionChunk{ chunk.chunkX, chunk.chunkY, {} };
+                regionChunk.blocks.reserve(chunk.blocks.size());
+                for (const auto& block : chunk.blocks) regionChunk.blocks.push_back(createBlock(block));
+                region.push_back(std::move(regionChunk));
+                for (const auto& entity : chunk.entities) entities.push_back(createEntityS(entity));
+                updated.chunks.push_back(entry);
+                continue;
             }
         }
+
+        auto entityStart = oldEntities.begin() + static_cast<std::ptrdiff_t>(entry.entityOffset);
+        entry.modTime = previous[i] ? modTimes[i] : entry.modTime;
+        entry.entityOffset = entities.size();
+        removedChunks.erase({ entry.chunkX, entry.chunkY });
+        region.push_back({ entry.chunkX, entry.chunkY, std::move(oldChunks[{ entry.chunkX, entry.chunkY }]) });
+        entities.insert(entities.end(), entityStart, entityStart + static_cast<std::ptrdiff_t>(entry.entityCount));
+        updated.chunks.push_back(entry);
+    }
+
+    if (mapSaver) mapSaver->writeRegion(std::move(region));
+    rewriteFile(entitiesFile, path / "entities.bin", entities);
+
+    if (!updated.save(path / "import_manifest.json")) {
+        std::cerr << "[WARNING] Nie można zapisać manifestu importu" << std::endl;
     }
 
     refresh();
-    std::cout << "[SYSTEM] Import zakończony." << std::endl;
-}
\ No newline at end of file
+    std::cout << "[SYSTEM] Import zakończony: " << changed.size() << " z " << files.size() << " chunków zaimportowanych." << std::endl;
+
+    changedChunks.insert(changedChunks.end(), removedChunks.begin(), removedChunks.end());
+    return changedChunks;
+}
@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <vector>
 #include "Map/map.hpp"
 #include "Entities/entities.hpp"
 
@@ -22,6 +23,8 @@ private:
     std::unique_ptr<EntitySaver> entitySavesSaver;
 
     void openFile(std::fstream& file, const std::filesystem::path& filePath);
+    std::vector<uint64_t> readRecords(std::fstream& file);
+    void rewriteFile(std::fstream& file, const std::filesystem::path& filePath, const std::vector<uint64_t>& records);
 
 public:
     explicit Saves(const std::string& pathToFolder);
@@ -37,5 +40,6 @@ public:
     EntitySaver& saveEntityToMap();
     void clearSaveData();
 
-    void loadFromEditorDir(const std::string& pathToFolder);
+    // Incremental import; returns the (chunkX, chunkY) of every chunk whose blocks changed or vanished.
+    std::vector<std::pair<int, int>> loadFromEditorDir(const std::string& pathToFolder);
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "GUI/GUI_raylib.hpp"
 #include "Scenes/scene_functions.hpp"
 #include "Core/GameConstants.hpp"
+#include "Core/AssetCache.hpp"
 
 inline void sceneMainMenu(int windowWidth, int windowHeight, bool& shouldQuit, int& state) {
 
@@ -23,10 +24,15 @@ inline void sceneMainMenu(int windowWidth, int windowHeight, bool& shouldQuit, i
     float starsBigY = 0.0f;
 
     bool shouldLeave = false;
-    Texture2D noStarsBackground = LoadTexture("assets/backgrounds/background_no_stars.png");
-    Texture2D starsBigBackground = LoadTexture("assets/backgrounds/background_stars_big.png");
-    Texture2D starsSmall0Background = LoadTexture("assets/backgrounds/background_stars_small0.png");
-    Texture2D starsSmall1Background = LoadTexture("assets/backgrounds/background_stars_small1.png");
+    // Shared through AssetCache, so coming back to the menu does not decode the PNGs again
+    const std::string noStarsPath = "assets/backgrounds/background_no_stars.png";
+    const std::string starsBigPath = "assets/backgrounds/background_stars_big.png";
+    const std::string starsSmall0Path = "assets/backgrounds/background_stars_small0.png";
+    const std::string starsSmall1Path = "assets/backgrounds/background_stars_small1.png";
+    Texture2D noStarsBackground = AssetCache::shared().acquireTexture(noStarsPath);
+    Texture2D starsBigBackground = AssetCache::shared().acquireTexture(starsBigPath);
+    Texture2D starsSmall0Background = AssetCache::shared().acquireTexture(starsSmall0Path);
+    Texture2D starsSmall1Background = AssetCache::shared().acquireTexture(starsSmall1Path);
 
     Rectangle b = { 0, 0, 0, 0 };
 
@@ -119,8 +125,8 @@ inline void sceneMainMenu(int windowWidth, int windowHeight, bool& shouldQuit, i
         EndDrawing();
     }
 
-    UnloadTexture(noStarsBackground);
-    UnloadTexture(starsBigBackground);
-    UnloadTexture(starsSmall0Background);
-    UnloadTexture(starsSmall1Background);
+    AssetCache::shared().releaseTexture(noStarsPath);
+    AssetCache::shared().releaseTexture(starsBigPath);
+    AssetCache::shared().releaseTexture(starsSmall0Path);
+    AssetCache::shared().releaseTexture(starsSmall1Path);
 }
\ No newline at end of file
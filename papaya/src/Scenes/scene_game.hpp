@@ -1,3 +0,0 @@
-#pragma once
-
-void sceneGame(int windowWidth, int windowHeight, bool& shouldQuit, int& state);
\ No newline at end of file
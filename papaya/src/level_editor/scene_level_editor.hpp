@@ -7,6 +7,7 @@
 #include "GUI/GUI_raylib.hpp"
 #include "Scenes/scene_functions.hpp"
 #include "level_editor/functions_level_editor.hpp"
+#include "Core/AssetCache.hpp"
 
 
 void sceneLevelEditor(bool& shouldQuit, int& state, int windowHeight, int windowWidth) {
@@ -25,8 +26,10 @@ void sceneLevelEditor(bool& shouldQuit, int& state, int windowHeight, int window
 	float selectionScrollTimer = 0.0f;
 
 
-	Texture2D textureAtlas = LoadTexture("assets/tiles/atlas_512x512.png");
-	Texture2D spriteAtlas = LoadTexture("assets/sprites/entity_atlas_v0.png");
+	const std::string textureAtlasPath = "assets/tiles/atlas_512x512.png";
+	const std::string spriteAtlasPath = "assets/sprites/entity_atlas_v0.png";
+	Texture2D textureAtlas = AssetCache::shared().acquireTexture(textureAtlasPath);
+	Texture2D spriteAtlas = AssetCache::shared().acquireTexture(spriteAtlasPath);
 	int chunkX = 0;
 	int chunkY = 0;
 	
@@ -563,10 +566,8 @@ void sceneLevelEditor(bool& shouldQuit, int& state, int windowHeight, int window
 		if (IsKeyPressed(KEY_F1)) std::cout << MousePosition::sMousePos.x << " : " << MousePosition::sMousePos.y << std::endl;
 		//hot reload of the atlas
 		if (IsKeyPressed(KEY_F2)) {
-			UnloadTexture(textureAtlas);
-			UnloadTexture(spriteAtlas);
-			textureAtlas = LoadTexture("assets/tiles/atlas_512x512.png");
-			Texture2D spriteAtlas = LoadTexture("assets/sprites/entity_atlas_v0.png");
+			textureAtlas = AssetCache::shared().reloadTexture(textureAtlasPath);
+			spriteAtlas = AssetCache::shared().reloadTexture(spriteAtlasPath);
 		}
 
 		if (isCheatsheetVisible) pCheatsheet->draw();
@@ -586,8 +587,8 @@ void sceneLevelEditor(bool& shouldQuit, int& state, int windowHeight, int window
 		
 	}
 
-	UnloadTexture(textureAtlas);
-	UnloadTexture(spriteAtlas);
+	AssetCache::shared().releaseTexture(textureAtlasPath);
+	AssetCache::shared().releaseTexture(spriteAtlasPath);
 	
 	autoSave(pDrawingScreen, chunkX, chunkY);
 }
@@ -4,6 +4,8 @@
 #include "Scenes/main_menu.hpp"
 #include "level_editor/scene_level_editor.hpp"
 #include "Core/GameWrapper.hpp"
+#include "Core/AssetCache.hpp"
+#include "Audio/AudioManager.hpp"
 
 int main() {
     std::cout << "Starting Papaya Engine...\n";
@@ -19,34 +21,40 @@ int main() {
     int previousState = 0;
     bool shouldQuit = false;
 
-    GameWrapper game(shouldQuit, state);
+    {
+        GameWrapper game(shouldQuit, state);
 
-    while (!WindowShouldClose() && !shouldQuit) {
+        while (!WindowShouldClose() && !shouldQuit) {
 
-        if (previousState == 0 && state == 1) {
-            game.reloadSave();
-        }
-        previousState = state;
+            if (previousState == 0 && state == 1) {
+                game.reloadSave();
+            }
+            previousState = state;
 
-        switch (state) {
-        case 0:
-            sceneMainMenu(WINDOW_W, WINDOW_H, shouldQuit, state);
-            break;
+            switch (state) {
+            case 0:
+                sceneMainMenu(WINDOW_W, WINDOW_H, shouldQuit, state);
+                break;
 
-        case 1:
-            game.runFrame(GetScreenWidth(), GetScreenHeight());
-            break;
+            case 1:
+                game.runFrame(GetScreenWidth(), GetScreenHeight());
+                break;
 
-        case 2:
-            sceneLevelEditor(shouldQuit, state, WINDOW_H, WINDOW_W);
-            break;
+            case 2:
+                sceneLevelEditor(shouldQuit, state, WINDOW_H, WINDOW_W);
+                break;
 
-        default:
-            state = 0;
-            break;
+            default:
+                state = 0;
+                break;
+            }
         }
-    }
+    } // ~GameWrapper joins the music thread, which still plays streams owned by the cache
 
+    // The cache goes last: every holder has released by now, and its textures and sounds still
+    // need the GL context and the audio device, which are closed only after it
+    AssetCache::shared().clear();
+    AudioManager::getInstance()->shutdown();
     CloseWindow();
     return 0;
 }
\ No newline at end of file